@@ -0,0 +1,633 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ggems_benchmark.cc
+
+  \brief Benchmark measuring startup time, kernel time and photon throughput on standard scenarios
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+#include "GGEMS/global/GGEMSOpenCLManager.hh"
+#include "GGEMS/global/GGEMS.hh"
+#include "GGEMS/materials/GGEMSMaterialsDatabaseManager.hh"
+#include "GGEMS/navigators/GGEMSVoxelizedPhantom.hh"
+#include "GGEMS/navigators/GGEMSCTSystem.hh"
+#include "GGEMS/navigators/GGEMSDosimetryCalculator.hh"
+#include "GGEMS/navigators/GGEMSWorld.hh"
+#include "GGEMS/physics/GGEMSRangeCutsManager.hh"
+#include "GGEMS/physics/GGEMSProcessesManager.hh"
+#include "GGEMS/sources/GGEMSXRaySource.hh"
+#include "GGEMS/geometries/GGEMSVolumeCreatorManager.hh"
+#include "GGEMS/geometries/GGEMSBox.hh"
+#include "GGEMS/geometries/GGEMSTube.hh"
+#include "GGEMS/geometries/GGEMSSphere.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
+
+#ifdef _WIN32
+#include "GGEMS/tools/GGEMSWinGetOpt.hh"
+#else
+#include <getopt.h>
+#endif
+
+namespace {
+  /*!
+    \struct GGEMSBenchmarkTimes_t
+    \brief Wall-clock times measured during a benchmark scenario
+  */
+  typedef struct GGEMSBenchmarkTimes_t
+  {
+    DurationNano startup_; /*!< Time spent in GGEMS::Initialize (kernel compilation, tables, buffers) */
+    DurationNano run_; /*!< Time spent in GGEMS::Run */
+  } GGEMSBenchmarkTimes; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+  /*!
+    \fn void PrintHelpAndQuit(std::string const& message, char const *exec)
+    \param message - error message
+    \param exec - name of the executable
+    \brief print the help or the error of the program
+  */
+  [[noreturn]] void PrintHelpAndQuit(std::string const& message, char const* exec)
+  {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << message << std::endl;
+    oss << std::endl;
+    oss << "-->> GGEMS Benchmark <<--\n" << std::endl;
+    oss << "Usage: " << exec << " [OPTIONS...]\n" << std::endl;
+    oss << "[--help]                   Print the help to the terminal" << std::endl;
+    oss << "[--verbose X]              Verbosity level" << std::endl;
+    oss << "                           (X=0, default)" << std::endl;
+    oss << std::endl;
+    oss << "Specific hardware selection:" << std::endl;
+    oss << "----------------------------" << std::endl;
+    oss << "[--device X]               Device type:" << std::endl;
+    oss << "                           (X=cpu, by default)" << std::endl;
+    oss << "                               - all (all devices)" << std::endl;
+    oss << "                               - cpu (cpu device, POCL included)" << std::endl;
+    oss << "                               - gpu (all gpu devices)" << std::endl;
+    oss << "                               - gpu_nvidia (all gpu nvidia devices)" << std::endl;
+    oss << "                               - gpu_intel (all gpu intel devices)" << std::endl;
+    oss << "                               - gpu_amd (all gpu amd devices)" << std::endl;
+    oss << "                               - X;Y;Z ... (index of device)" << std::endl;
+    oss << std::endl;
+    oss << "Benchmark parameters:" << std::endl;
+    oss << "---------------------" << std::endl;
+    oss << "[--scenario X]            Scenario to run, one scenario by process" << std::endl;
+    oss << "                          (X=water_box, default)" << std::endl;
+    oss << "                              - water_box (dosimetry in a voxelized water box)" << std::endl;
+    oss << "                              - ct_phantom (voxelized CT phantom and curved CT detector)" << std::endl;
+    oss << "                              - ct_detector (flat CT detector alone, histogram mode)" << std::endl;
+    oss << "                              - world_tracking (phantom, CT detector and world tracking)" << std::endl;
+    oss << "[--n-particles X]         Number of particles" << std::endl;
+    oss << "                          (X=1000000, default)" << std::endl;
+    oss << "[--batch-size X]          Number of particles by batch, 0 for automatic sizing" << std::endl;
+    oss << "                          (X=MAXIMUM_PARTICLES, default)" << std::endl;
+    oss << "[--seed X]                Seed of pseudo generator number" << std::endl;
+    oss << "                          (X=777, default)" << std::endl;
+    oss << "[--output X]              JSON lines file, one line appended by run" << std::endl;
+    oss << "                          (X=benchmark.jsonl, default)" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  /*!
+    \fn void ParseCommandLine(std::string const& line_option, T* p_buffer)
+    \tparam T - type of the array storing the option
+    \param line_option - string from the command line
+    \param p_buffer - buffer storing the commands
+    \brief parse the command with comma
+  */
+  template<typename T>
+  void ParseCommandLine(std::string const& line_option, T* p_buffer)
+  {
+    std::istringstream iss(line_option);
+    T* p = &p_buffer[0];
+    while (iss >> *p++) if (iss.peek() == ',') iss.ignore();
+  }
+
+  /*!
+    \fn std::string EscapeJSON(std::string const& text)
+    \param text - text to escape
+    \return text escaped for a JSON string
+    \brief escape quotes, backslashes and control characters for JSON output
+  */
+  std::string EscapeJSON(std::string const& text)
+  {
+    std::ostringstream oss(std::ostringstream::out);
+    for (auto&& c: text) {
+      if (c == '"') oss << "\\\"";
+      else if (c == '\\') oss << "\\\\";
+      else if (static_cast<unsigned char>(c) < 0x20) oss << ' ';
+      else oss << c;
+    }
+    return oss.str();
+  }
+
+  /*!
+    \fn GGdouble ToSeconds(DurationNano const& duration)
+    \param duration - duration in ns
+    \return duration in s
+    \brief convert a duration in seconds
+  */
+  GGdouble ToSeconds(DurationNano const& duration)
+  {
+    return std::chrono::duration<GGdouble>(duration).count();
+  }
+
+  /*!
+    \fn void CreateVoxelizedPhantom(std::string const& basename, bool const& is_ct_phantom)
+    \param basename - basename of phantom files in data folder
+    \param is_ct_phantom - add bone and lung inserts in a water cylinder, otherwise a water box
+    \brief voxelize the phantom used by the benchmark
+  */
+  void CreateVoxelizedPhantom(std::string const& basename, bool const& is_ct_phantom)
+  {
+    GGEMSVolumeCreatorManager& volume_creator_manager = GGEMSVolumeCreatorManager::GetInstance();
+
+    volume_creator_manager.SetVolumeDimensions(200, 200, 200);
+    volume_creator_manager.SetElementSizes(1.0f, 1.0f, 1.0f, "mm");
+    volume_creator_manager.SetOutputImageFilename("data/" + basename + ".mhd");
+    volume_creator_manager.SetRangeToMaterialDataFilename("data/range_" + basename + ".txt");
+    volume_creator_manager.SetMaterial("Air");
+    volume_creator_manager.SetDataType("MET_INT");
+    volume_creator_manager.Initialize();
+
+    if (is_ct_phantom) {
+      GGEMSTube* tube_phantom = new GGEMSTube(80.0f, 80.0f, 180.0f, "mm");
+      tube_phantom->SetPosition(0.0f, 0.0f, 0.0f, "mm");
+      tube_phantom->SetLabelValue(1);
+      tube_phantom->SetMaterial("Water");
+      tube_phantom->Initialize();
+      tube_phantom->Draw();
+      delete tube_phantom;
+
+      GGEMSBox* bone_insert = new GGEMSBox(20.0f, 20.0f, 180.0f, "mm");
+      bone_insert->SetPosition(-40.0f, 0.0f, 0.0f, "mm");
+      bone_insert->SetLabelValue(2);
+      bone_insert->SetMaterial("RibBone");
+      bone_insert->Initialize();
+      bone_insert->Draw();
+      delete bone_insert;
+
+      GGEMSSphere* lung_insert = new GGEMSSphere(25.0f, "mm");
+      lung_insert->SetPosition(35.0f, 0.0f, 0.0f, "mm");
+      lung_insert->SetLabelValue(3);
+      lung_insert->SetMaterial("Lung");
+      lung_insert->Initialize();
+      lung_insert->Draw();
+      delete lung_insert;
+    }
+    else {
+      GGEMSBox* box_phantom = new GGEMSBox(180.0f, 180.0f, 180.0f, "mm");
+      box_phantom->SetPosition(0.0f, 0.0f, 0.0f, "mm");
+      box_phantom->SetLabelValue(1);
+      box_phantom->SetMaterial("Water");
+      box_phantom->Initialize();
+      box_phantom->Draw();
+      delete box_phantom;
+    }
+
+    volume_creator_manager.Write();
+  }
+
+  /*!
+    \fn void SetPhysics(void)
+    \brief activate photon processes and cuts, same physics for all scenarios
+  */
+  void SetPhysics(void)
+  {
+    GGEMSProcessesManager& processes_manager = GGEMSProcessesManager::GetInstance();
+    GGEMSRangeCutsManager& range_cuts_manager = GGEMSRangeCutsManager::GetInstance();
+
+    processes_manager.AddProcess("Compton", "gamma", "all");
+    processes_manager.AddProcess("Photoelectric", "gamma", "all");
+    processes_manager.AddProcess("Rayleigh", "gamma", "all");
+
+    processes_manager.SetCrossSectionTableNumberOfBins(220);
+    processes_manager.SetCrossSectionTableMinimumEnergy(1.0f, "keV");
+    processes_manager.SetCrossSectionTableMaximumEnergy(1.0f, "MeV");
+
+    range_cuts_manager.SetLengthCut("all", "gamma", 0.1f, "mm");
+  }
+
+  /*!
+    \fn void SetSource(GGEMSXRaySource& source, GGsize const& number_of_particles, GGfloat const& source_isocenter_distance, GGfloat const& beam_aperture)
+    \param source - x-ray source to set
+    \param number_of_particles - number of particles
+    \param source_isocenter_distance - distance between source and isocenter in mm
+    \param beam_aperture - beam aperture in degree
+    \brief set the polychromatic point source used by all scenarios
+  */
+  void SetSource(GGEMSXRaySource& source, GGsize const& number_of_particles, GGfloat const& source_isocenter_distance, GGfloat const& beam_aperture)
+  {
+    source.SetSourceParticleType("gamma");
+    source.SetNumberOfParticles(number_of_particles);
+    source.SetPosition(-source_isocenter_distance, 0.0f, 0.0f, "mm");
+    source.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    source.SetBeamAperture(beam_aperture, "deg");
+    source.SetFocalSpotSize(0.0f, 0.0f, 0.0f, "mm");
+    source.SetPolyenergy("data/spectrum_120kVp_2mmAl.dat");
+  }
+
+  /*!
+    \fn GGEMSBenchmarkTimes RunSimulation(GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+    \param seed - seed of the random
+    \param particle_batch_size - number of particles by batch
+    \param is_batch_size - true if batch size is given by the user
+    \return startup and run times
+    \brief initialize and run GGEMS, measuring both steps, and wait for all profiling callbacks
+  */
+  GGEMSBenchmarkTimes RunSimulation(GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+  {
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    GGEMSProfilerManager& profiler_manager = GGEMSProfilerManager::GetInstance();
+
+    GGEMS ggems;
+    ggems.SetOpenCLVerbose(false);
+    ggems.SetMaterialDatabaseVerbose(false);
+    ggems.SetNavigatorVerbose(false);
+    ggems.SetSourceVerbose(false);
+    ggems.SetMemoryRAMVerbose(false);
+    ggems.SetProcessVerbose(false);
+    ggems.SetRangeCutsVerbose(false);
+    ggems.SetRandomVerbose(false);
+    ggems.SetProfilingVerbose(false);
+    ggems.SetTrackingVerbose(false, 0);
+    if (is_batch_size) ggems.SetParticleBatchSize(particle_batch_size);
+
+    // Kernels launched during phantom voxelization are not part of the benchmark
+    profiler_manager.Reset();
+
+    GGEMSBenchmarkTimes times;
+
+    ChronoTime start_time = GGEMSChrono::Now();
+    ggems.Initialize(seed);
+    times.startup_ = GGEMSChrono::Now() - start_time;
+
+    start_time = GGEMSChrono::Now();
+    ggems.Run();
+    times.run_ = GGEMSChrono::Now() - start_time;
+
+    // Profiling data are filled by event callbacks, flushing queues before reading them
+    for (GGsize i = 0; i < opencl_manager.GetNumberOfActivatedDevice(); ++i) opencl_manager.GetCommandQueue(i)->finish();
+
+    return times;
+  }
+
+  /*!
+    \fn GGEMSBenchmarkTimes RunWaterBox(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+    \param number_of_particles - number of particles
+    \param seed - seed of the random
+    \param particle_batch_size - number of particles by batch
+    \param is_batch_size - true if batch size is given by the user
+    \return startup and run times
+    \brief dosimetry in a voxelized water box
+  */
+  GGEMSBenchmarkTimes RunWaterBox(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+  {
+    CreateVoxelizedPhantom("water_box", false);
+
+    GGEMSVoxelizedPhantom phantom("phantom");
+    phantom.SetPhantomFile("data/water_box.mhd", "data/range_water_box.txt");
+    phantom.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    phantom.SetPosition(0.0f, 0.0f, 0.0f, "mm");
+
+    GGEMSDosimetryCalculator dosimetry;
+    dosimetry.AttachToNavigator("phantom");
+    dosimetry.SetOutputDosimetryBasename("data/water_box_dosimetry");
+    dosimetry.SetDoselSizes(2.0f, 2.0f, 2.0f, "mm");
+    dosimetry.SetWaterReference(false);
+    dosimetry.SetMinimumDensity(0.1f, "g/cm3");
+    dosimetry.SetUncertainty(true);
+    dosimetry.SetEdep(true);
+    dosimetry.SetEdepSquared(true);
+
+    SetPhysics();
+
+    GGEMSXRaySource point_source("point_source");
+    SetSource(point_source, number_of_particles, 595.0f, 5.0f);
+
+    return RunSimulation(seed, particle_batch_size, is_batch_size);
+  }
+
+  /*!
+    \fn GGEMSBenchmarkTimes RunCTPhantom(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+    \param number_of_particles - number of particles
+    \param seed - seed of the random
+    \param particle_batch_size - number of particles by batch
+    \param is_batch_size - true if batch size is given by the user
+    \return startup and run times
+    \brief projection of a voxelized CT phantom on a curved CT detector
+  */
+  GGEMSBenchmarkTimes RunCTPhantom(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+  {
+    CreateVoxelizedPhantom("ct_phantom", true);
+
+    GGEMSVoxelizedPhantom phantom("phantom");
+    phantom.SetPhantomFile("data/ct_phantom.mhd", "data/range_ct_phantom.txt");
+    phantom.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    phantom.SetPosition(0.0f, 0.0f, 0.0f, "mm");
+
+    GGEMSCTSystem ct_detector("Stellar");
+    ct_detector.SetCTSystemType("curved");
+    ct_detector.SetNumberOfModules(1, 46);
+    ct_detector.SetNumberOfDetectionElementsInsideModule(64, 16, 1);
+    ct_detector.SetSizeOfDetectionElements(0.6f, 0.6f, 0.6f, "mm");
+    ct_detector.SetMaterialName("GOS");
+    ct_detector.SetSourceDetectorDistance(1085.6f, "mm");
+    ct_detector.SetSourceIsocenterDistance(595.0f, "mm");
+    ct_detector.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    ct_detector.SetThreshold(10.0f, "keV");
+    ct_detector.StoreOutput("data/ct_phantom_projection");
+    ct_detector.StoreScatter(true);
+
+    SetPhysics();
+
+    GGEMSXRaySource point_source("point_source");
+    SetSource(point_source, number_of_particles, 595.0f, 12.5f);
+
+    return RunSimulation(seed, particle_batch_size, is_batch_size);
+  }
+
+  /*!
+    \fn GGEMSBenchmarkTimes RunCTDetector(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+    \param number_of_particles - number of particles
+    \param seed - seed of the random
+    \param particle_batch_size - number of particles by batch
+    \param is_batch_size - true if batch size is given by the user
+    \return startup and run times
+    \brief flat CT detector alone recording histograms, measuring detector navigation without phantom
+  */
+  GGEMSBenchmarkTimes RunCTDetector(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+  {
+    GGEMSCTSystem ct_detector("custom");
+    ct_detector.SetCTSystemType("flat");
+    ct_detector.SetNumberOfModules(1, 1);
+    ct_detector.SetNumberOfDetectionElementsInsideModule(400, 400, 1);
+    ct_detector.SetSizeOfDetectionElements(1.0f, 1.0f, 10.0f, "mm");
+    ct_detector.SetMaterialName("Silicon");
+    ct_detector.SetSourceDetectorDistance(1500.0f, "mm");
+    ct_detector.SetSourceIsocenterDistance(900.0f, "mm");
+    ct_detector.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    ct_detector.SetThreshold(10.0f, "keV");
+    ct_detector.StoreOutput("data/ct_detector_projection");
+
+    SetPhysics();
+
+    GGEMSXRaySource point_source("point_source");
+    SetSource(point_source, number_of_particles, 900.0f, 12.0f);
+
+    return RunSimulation(seed, particle_batch_size, is_batch_size);
+  }
+
+  /*!
+    \fn GGEMSBenchmarkTimes RunWorldTracking(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+    \param number_of_particles - number of particles
+    \param seed - seed of the random
+    \param particle_batch_size - number of particles by batch
+    \param is_batch_size - true if batch size is given by the user
+    \return startup and run times
+    \brief water phantom and flat CT detector with photon tracking in the world
+  */
+  GGEMSBenchmarkTimes RunWorldTracking(GGsize const& number_of_particles, GGuint const& seed, GGsize const& particle_batch_size, bool const& is_batch_size)
+  {
+    CreateVoxelizedPhantom("world_phantom", false);
+
+    GGEMSWorld world;
+    world.SetDimension(200, 200, 200);
+    world.SetElementSize(10.0f, 10.0f, 10.0f, "mm");
+    world.SetOutputWorldBasename("data/world");
+    world.SetEnergyTracking(true);
+    world.SetPhotonTracking(true);
+
+    GGEMSVoxelizedPhantom phantom("phantom");
+    phantom.SetPhantomFile("data/world_phantom.mhd", "data/range_world_phantom.txt");
+    phantom.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    phantom.SetPosition(0.0f, 0.0f, 0.0f, "mm");
+
+    GGEMSCTSystem ct_detector("custom");
+    ct_detector.SetCTSystemType("flat");
+    ct_detector.SetNumberOfModules(1, 1);
+    ct_detector.SetNumberOfDetectionElementsInsideModule(400, 400, 1);
+    ct_detector.SetSizeOfDetectionElements(1.0f, 1.0f, 10.0f, "mm");
+    ct_detector.SetMaterialName("Silicon");
+    ct_detector.SetSourceDetectorDistance(1500.0f, "mm");
+    ct_detector.SetSourceIsocenterDistance(900.0f, "mm");
+    ct_detector.SetRotation(0.0f, 0.0f, 0.0f, "deg");
+    ct_detector.SetThreshold(10.0f, "keV");
+    ct_detector.StoreOutput("data/world_projection");
+
+    SetPhysics();
+
+    GGEMSXRaySource point_source("point_source");
+    SetSource(point_source, number_of_particles, 900.0f, 12.0f);
+
+    return RunSimulation(seed, particle_batch_size, is_batch_size);
+  }
+
+  /*!
+    \fn void WriteResults(std::ostream& stream, std::string const& scenario, GGsize const& number_of_particles, GGEMSBenchmarkTimes const& times)
+    \param stream - output stream
+    \param scenario - name of the scenario
+    \param number_of_particles - number of simulated particles
+    \param times - startup and run times
+    \brief write benchmark results as a single JSON line
+  */
+  void WriteResults(std::ostream& stream, std::string const& scenario, GGsize const& number_of_particles, GGEMSBenchmarkTimes const& times)
+  {
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    GGEMSProfilerManager& profiler_manager = GGEMSProfilerManager::GetInstance();
+
+    GGdouble run_time = ToSeconds(times.run_);
+    GGdouble photons_per_second = run_time > 0.0 ? static_cast<GGdouble>(number_of_particles) / run_time : 0.0;
+
+    stream << std::setprecision(9);
+    stream << "{\"scenario\": \"" << EscapeJSON(scenario) << "\"";
+
+    stream << ", \"devices\": [";
+    for (GGsize i = 0; i < opencl_manager.GetNumberOfActivatedDevice(); ++i) {
+      if (i != 0) stream << ", ";
+      stream << "\"" << EscapeJSON(opencl_manager.GetDeviceName(opencl_manager.GetIndexOfActivatedDevice(i))) << "\"";
+    }
+    stream << "]";
+
+    stream << ", \"particles\": " << number_of_particles;
+    stream << ", \"startup_s\": " << ToSeconds(times.startup_);
+    stream << ", \"run_s\": " << run_time;
+    stream << ", \"photons_per_second\": " << photons_per_second;
+
+    stream << ", \"kernels_s\": {";
+    bool is_first = true;
+    for (auto&& p: profiler_manager.GetSummaryProfile()) {
+      if (!is_first) stream << ", ";
+      stream << "\"" << EscapeJSON(p.first) << "\": " << ToSeconds(p.second);
+      is_first = false;
+    }
+    stream << "}}" << std::endl;
+  }
+}
+
+/*!
+  \fn int main(int argc, char** argv)
+  \param argc - number of arguments
+  \param argv - list of arguments
+  \return status of program
+  \brief main function of program
+*/
+int main(int argc, char** argv)
+{
+  GGint status = EXIT_SUCCESS;
+
+  try {
+    // Verbosity level
+    GGint verbosity_level = 0;
+
+    // List of parameters
+    GGsize number_of_particles = 1000000;
+    GGsize particle_batch_size = 0;
+    bool is_batch_size = false;
+    std::string device = "cpu";
+    std::string scenario = "water_box";
+    std::string output = "benchmark.jsonl";
+    GGuint seed = 777;
+
+    // Loop while there is an argument
+    GGint counter(0);
+    while (1) {
+      // Declaring a structure of the options
+      GGint option_index = 0;
+      static struct option sLongOptions[] = {
+        {"verbose", required_argument, nullptr, 'v'},
+        {"help", no_argument, nullptr, 'h'},
+        {"n-particles", required_argument, nullptr, 'p'},
+        {"batch-size", required_argument, nullptr, 'n'},
+        {"device", required_argument, nullptr, 'd'},
+        {"scenario", required_argument, nullptr, 'c'},
+        {"output", required_argument, nullptr, 'o'},
+        {"seed", required_argument, nullptr, 's'},
+        {nullptr, 0, nullptr, 0}
+      };
+
+      // Getting the options
+      counter = getopt_long(argc, argv, "hv:p:n:d:c:o:s:", sLongOptions, &option_index);
+
+      // Exit the loop if -1
+      if (counter == -1) break;
+
+      // Analyzing each option
+      switch (counter) {
+        case 0: {
+          // If this option set a flag, do nothing else now
+          if (sLongOptions[option_index].flag != nullptr) break;
+          break;
+        }
+        case 'v': {
+          ParseCommandLine(optarg, &verbosity_level);
+          break;
+        }
+        case 'h': {
+          PrintHelpAndQuit("Printing the help", argv[0]);
+        }
+        case 'p': {
+          ParseCommandLine(optarg, &number_of_particles);
+          break;
+        }
+        case 'n': {
+          ParseCommandLine(optarg, &particle_batch_size);
+          is_batch_size = true;
+          break;
+        }
+        case 'd': {
+          device = optarg;
+          break;
+        }
+        case 'c': {
+          scenario = optarg;
+          break;
+        }
+        case 'o': {
+          output = optarg;
+          break;
+        }
+        case 's': {
+          ParseCommandLine(optarg, &seed);
+          break;
+        }
+        default: {
+          PrintHelpAndQuit("Out of switch options!!!", argv[0]);
+        }
+      }
+    }
+
+    // Setting verbosity
+    GGcout.SetVerbosity(verbosity_level);
+    GGcerr.SetVerbosity(verbosity_level);
+    GGwarn.SetVerbosity(verbosity_level);
+
+    // Initialization of singletons
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    GGEMSMaterialsDatabaseManager& material_manager = GGEMSMaterialsDatabaseManager::GetInstance();
+
+    // Activating device
+    if (device == "gpu_nvidia") opencl_manager.DeviceToActivate("gpu", "nvidia");
+    else if (device == "gpu_amd") opencl_manager.DeviceToActivate("gpu", "amd");
+    else if (device == "gpu_intel") opencl_manager.DeviceToActivate("gpu", "intel");
+    else opencl_manager.DeviceToActivate(device);
+
+    // Enter material database
+    material_manager.SetMaterialsDatabase("data/materials.txt");
+
+    // Running scenario, managers are singletons so only one scenario by process
+    GGEMSBenchmarkTimes times;
+    if (scenario == "water_box") times = RunWaterBox(number_of_particles, seed, particle_batch_size, is_batch_size);
+    else if (scenario == "ct_phantom") times = RunCTPhantom(number_of_particles, seed, particle_batch_size, is_batch_size);
+    else if (scenario == "ct_detector") times = RunCTDetector(number_of_particles, seed, particle_batch_size, is_batch_size);
+    else if (scenario == "world_tracking") times = RunWorldTracking(number_of_particles, seed, particle_batch_size, is_batch_size);
+    else PrintHelpAndQuit("Unknown scenario '" + scenario + "'!!!", argv[0]);
+
+    // Appending results
+    std::ofstream output_stream(output, std::ios::out | std::ios::app);
+    if (!output_stream) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Problem opening '" << output << "' for benchmark results!!!";
+      throw std::runtime_error(oss.str());
+    }
+    WriteResults(output_stream, scenario, number_of_particles, times);
+    output_stream.close();
+  }
+  catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    status = EXIT_FAILURE;
+  }
+  catch (...) {
+    std::cerr << "Unknown exception!!!" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // Exit safely
+  GGEMSOpenCLManager::GetInstance().Clean();
+  exit(status);
+}
@@ -108,6 +108,13 @@ class GGEMS_EXPORT GGEMSSolid
     */
     inline cl::Buffer* GetLabelData(GGsize const& thread_index) const {return label_data_[thread_index];}
 
+    /*!
+      \fn inline GGsize GetLabelSize(void) const
+      \brief get the size in bytes of a label, 1 byte or 2 bytes if more than 255 materials
+      \return size of a label element
+    */
+    inline GGsize GetLabelSize(void) const {return label_size_;}
+
     /*!
       \fn void SetRotation(GGfloat3 const& rotation_xyz)
       \param rotation_xyz - rotation in X, Y and Z
@@ -208,6 +215,13 @@ class GGEMS_EXPORT GGEMSSolid
     */
     inline std::string GetRegisteredDataType(void) const {return data_reg_type_;}
 
+    /*!
+      \fn std::string GetKernelOption(void) const
+      \return preprocessor options used to compile the kernels of the solid
+      \brief get the preprocessor options of the solid kernels
+    */
+    inline std::string GetKernelOption(void) const {return kernel_option_;}
+
     /*!
       \fn cl::Kernel* GetKernelParticleSolidDistance(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -301,6 +315,7 @@ class GGEMS_EXPORT GGEMSSolid
     cl::Buffer** solid_data_; /*!< Data about solid */
     cl::Buffer** label_data_; /*!< Pointer storing the buffer about label data, useful for voxelized solid only */
     std::size_t number_of_voxels_; /*!< Number of voxel 1 for GGEMSSolidBox */
+    GGsize label_size_; /*!< Size of a label element in bytes, GGuchar or GGushort */
     GGsize number_activated_devices_; /*!< Number of activated device */
 
     // Geometric transformation applyied to solid
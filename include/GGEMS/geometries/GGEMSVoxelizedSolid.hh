@@ -31,8 +31,14 @@
   \date Wednesday June 10, 2020
 */
 
+#include <atomic>
+#include <numeric>
+#include <type_traits>
+
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
 #include "GGEMS/geometries/GGEMSSolid.hh"
+#include "GGEMS/physics/GGEMSProcessesManager.hh"
+#include "GGEMS/tools/GGEMSTools.hh"
 
 /*!
   \class GGEMSVoxelizedSolid
@@ -143,6 +149,17 @@ class GGEMS_EXPORT GGEMSVoxelizedSolid : public GGEMSSolid
     template <typename T>
     void ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials);
 
+    /*!
+      \fn template <typename T, typename L> void FillLabelData(std::vector<T> const& raw_data, std::vector<std::pair<GGfloat, GGfloat>> const& label_ranges)
+      \tparam T - type of data
+      \tparam L - type of label, GGuchar or GGushort
+      \param raw_data - image data read from raw file
+      \param label_ranges - first and last values of each label, in range file order
+      \brief compute labels on host in a single pass and upload them on each OpenCL device
+    */
+    template <typename T, typename L>
+    void FillLabelData(std::vector<T> const& raw_data, std::vector<std::pair<GGfloat, GGfloat>> const& label_ranges);
+
     /*!
       \fn void InitializeKernel(void)
       \brief Initialize kernel for particle solid distance
@@ -166,93 +183,185 @@ void GGEMSVoxelizedSolid::ConvertImageToLabel(std::string const& raw_data_filena
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  for (GGsize d = 0; d < number_activated_devices_; ++d) {
-    // Get pointer on OpenCL device
-    GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), d);
+  // Get information about mhd file, same header on each device
+  GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[0], CL_TRUE, CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), 0);
+  number_of_voxels_ = static_cast<GGsize>(solid_data_device->number_of_voxels_);
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[0], solid_data_device, 0);
+
+  // Opening range data file
+  std::ifstream in_range_stream(range_data_filename, std::ios::in);
+  GGEMSFileStream::CheckInputStream(in_range_stream, range_data_filename);
+
+  // Values in the range file
+  GGfloat first_label_value = 0.0f;
+  GGfloat last_label_value = 0.0f;
+  std::string material_name("");
+  std::vector<std::pair<GGfloat, GGfloat>> label_ranges;
+
+  // Reading range file, index of label is the line of material
+  std::string line("");
+  while (std::getline(in_range_stream, line)) {
+    // Check if blank line
+    if (GGEMSTextReader::IsBlankLine(line)) continue;
+
+    // Getting the value in string stream
+    std::istringstream iss = GGEMSRangeReader::ReadRangeMaterial(line);
+    iss >> first_label_value >> last_label_value >> material_name;
+
+    materials->AddMaterial(material_name);
+    label_ranges.push_back(std::make_pair(first_label_value, last_label_value));
+  }
 
-    // Get information about mhd file
-    number_of_voxels_ = static_cast<GGsize>(solid_data_device->number_of_voxels_);
+  // Closing file
+  in_range_stream.close();
 
-    // Release the pointer
-    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  // Checking if file exists
+  std::ifstream in_raw_stream(raw_data_filename, std::ios::in | std::ios::binary);
+  GGEMSFileStream::CheckInputStream(in_raw_stream, raw_data_filename);
 
-    // Checking if file exists
-    std::ifstream in_raw_stream(raw_data_filename, std::ios::in | std::ios::binary);
-    GGEMSFileStream::CheckInputStream(in_raw_stream, raw_data_filename);
+  // Reading data once for all devices
+  std::vector<T> raw_data(number_of_voxels_);
+  in_raw_stream.read(reinterpret_cast<char*>(&raw_data[0]), static_cast<std::streamsize>(number_of_voxels_ * sizeof(T)));
 
-    // Reading data to a tmp buffer
-    std::vector<T> tmp_raw_data;
-    tmp_raw_data.resize(number_of_voxels_);
-    in_raw_stream.read(reinterpret_cast<char*>(&tmp_raw_data[0]), static_cast<std::streamsize>(number_of_voxels_ * sizeof(T)));
+  // Closing file
+  in_raw_stream.close();
 
-    // Closing file
-    in_raw_stream.close();
+  // Max of label type is reserved to unconverted voxels, labels on 8 bits are kept up to 255 materials
+  GGsize number_of_labels = label_ranges.size();
+  if (number_of_labels < std::numeric_limits<GGuchar>::max()) {
+    label_size_ = sizeof(GGuchar);
+    FillLabelData<T, GGuchar>(raw_data, label_ranges);
+  }
+  else if (number_of_labels < std::numeric_limits<GGushort>::max()) {
+    GGcout("GGEMSVoxelizedSolid", "ConvertImageToLabel", 2) << number_of_labels << " materials in range file, labels stored on 16 bits..." << GGendl;
+    label_size_ = sizeof(GGushort);
+    if (kernel_option_.find(" -DLABEL_16BIT") == std::string::npos) kernel_option_ += " -DLABEL_16BIT";
+    FillLabelData<T, GGushort>(raw_data, label_ranges);
+  }
+  else {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Too many materials in range data file: " << number_of_labels << ", the limit is " << std::numeric_limits<GGushort>::max()-1 << " materials!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "ConvertImageToLabel", oss.str());
+  }
+}
 
-    // Allocating memory on OpenCL device
-    label_data_[d] = opencl_manager.Allocate(nullptr, number_of_voxels_ * sizeof(GGuchar), d, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
-    // Get pointer on OpenCL device
-    GGuchar* label_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels_ * sizeof(GGuchar), d);
-
-    // Set value to max of GGuchar
-    std::fill(label_data_device, label_data_device + number_of_voxels_, std::numeric_limits<GGuchar>::max());
-
-    // Opening range data file
-    std::ifstream in_range_stream(range_data_filename, std::ios::in);
-    GGEMSFileStream::CheckInputStream(in_range_stream, range_data_filename);
-
-    // Values in the range file
-    GGfloat first_label_value = 0.0f;
-    GGfloat last_label_value = 0.0f;
-    GGuchar label_index = 0;
-    std::string material_name("");
-
-    // Reading range file
-    std::string line("");
-    while (std::getline(in_range_stream, line)) {
-      // Check if blank line
-      if (GGEMSTextReader::IsBlankLine(line)) continue;
-
-      // Getting the value in string stream
-      std::istringstream iss = GGEMSRangeReader::ReadRangeMaterial(line);
-      iss >> first_label_value >> last_label_value >> material_name;
-
-      // Adding the material only once
-      if (d == 0) materials->AddMaterial(material_name);
-
-      // Setting the label
-      for (GGsize i = 0; i < number_of_voxels_; ++i) {
-        // Getting the value of phantom
-        GGfloat value = static_cast<GGfloat>(tmp_raw_data[i]);
-        if (((value == first_label_value) && (value == last_label_value)) || ((value >= first_label_value) && (value < last_label_value))) {
-          label_data_device[i] = label_index;
-        }
+template <typename T, typename L>
+void GGEMSVoxelizedSolid::FillLabelData(std::vector<T> const& raw_data, std::vector<std::pair<GGfloat, GGfloat>> const& label_ranges)
+{
+  // A value is in a range [first, last[, or equal to first and last for a single value
+  auto is_in_range = [](GGfloat const value, std::pair<GGfloat, GGfloat> const& range) {
+    return ((value == range.first) && (value == range.second)) || ((value >= range.first) && (value < range.second));
+  };
+
+  // Labels computed on host, max of label type for unconverted voxels
+  std::vector<L> labels(number_of_voxels_, std::numeric_limits<L>::max());
+  GGsize const kNumberOfRanges = label_ranges.size();
+
+  // Voxels are converted by chunks on host threads
+  GGsize const kChunkSize = 65536;
+  GGsize number_of_chunks = (number_of_voxels_ + kChunkSize - 1) / kChunkSize;
+  GGsize number_of_threads = GGEMSProcessesManager::GetInstance().GetNumberOfHostThreads();
+  std::atomic<bool> all_converted(true);
+
+  if constexpr (std::is_integral<T>::value && sizeof(T) <= sizeof(GGushort)) {
+    // Direct lookup table for 8 and 16 bits images, ranges applied in file order so the last matching range wins
+    GGint const kMinValue = static_cast<GGint>(std::numeric_limits<T>::min());
+    GGint const kMaxValue = static_cast<GGint>(std::numeric_limits<T>::max());
+    std::vector<L> lut(static_cast<GGsize>(kMaxValue - kMinValue + 1), std::numeric_limits<L>::max());
+
+    for (GGsize r = 0; r < kNumberOfRanges; ++r) {
+      if (label_ranges[r].first > static_cast<GGfloat>(kMaxValue)) continue;
+      GGint first_value = label_ranges[r].first < static_cast<GGfloat>(kMinValue) ? kMinValue : static_cast<GGint>(std::ceil(label_ranges[r].first));
+      for (GGint v = first_value; v <= kMaxValue; ++v) {
+        GGfloat value = static_cast<GGfloat>(v);
+        if (is_in_range(value, label_ranges[r])) lut[static_cast<GGsize>(v - kMinValue)] = static_cast<L>(r);
+        else if (value >= label_ranges[r].second) break;
       }
-
-      // Increment the label index
-      ++label_index;
     }
 
-    // Final loop checking if a value is still max of GGuchar
-    bool all_converted = true;
-    for (GGsize i = 0; i < number_of_voxels_; ++i) {
-      if (label_data_device[i] == std::numeric_limits<GGuchar>::max()) all_converted = false;
+    GGEMSMisc::ParallelFor(number_of_chunks, number_of_threads, [&](GGsize const& chunk_id) {
+      GGsize last_voxel = std::min((chunk_id + 1) * kChunkSize, number_of_voxels_);
+      bool chunk_converted = true;
+      for (GGsize i = chunk_id * kChunkSize; i < last_voxel; ++i) {
+        labels[i] = lut[static_cast<GGsize>(static_cast<GGint>(raw_data[i]) - kMinValue)];
+        chunk_converted &= (labels[i] != std::numeric_limits<L>::max());
+      }
+      if (!chunk_converted) all_converted = false;
+    });
+  }
+  else {
+    // Ranges sorted by first value, a binary search is valid only if ranges do not overlap
+    std::vector<GGsize> sorted_ranges(kNumberOfRanges);
+    std::iota(sorted_ranges.begin(), sorted_ranges.end(), 0);
+    std::stable_sort(sorted_ranges.begin(), sorted_ranges.end(), [&label_ranges](GGsize const& lhs, GGsize const& rhs) {
+      return label_ranges[lhs].first < label_ranges[rhs].first;
+    });
+
+    bool is_overlapping = false;
+    for (GGsize k = 1; k < kNumberOfRanges; ++k) {
+      std::pair<GGfloat, GGfloat> const& previous_range = label_ranges[sorted_ranges[k-1]];
+      std::pair<GGfloat, GGfloat> const& current_range = label_ranges[sorted_ranges[k]];
+      if (current_range.first < previous_range.second || current_range.first == previous_range.first) is_overlapping = true;
     }
 
-    // Closing file
-    in_range_stream.close();
-    tmp_raw_data.clear();
+    std::vector<GGfloat> sorted_first_values(kNumberOfRanges);
+    for (GGsize k = 0; k < kNumberOfRanges; ++k) sorted_first_values[k] = label_ranges[sorted_ranges[k]].first;
+
+    GGEMSMisc::ParallelFor(number_of_chunks, number_of_threads, [&](GGsize const& chunk_id) {
+      GGsize last_voxel = std::min((chunk_id + 1) * kChunkSize, number_of_voxels_);
+      bool chunk_converted = true;
+      for (GGsize i = chunk_id * kChunkSize; i < last_voxel; ++i) {
+        GGfloat value = static_cast<GGfloat>(raw_data[i]);
+        if (!is_overlapping) {
+          // Last range starting before value is the only candidate
+          std::vector<GGfloat>::const_iterator iter = std::upper_bound(sorted_first_values.begin(), sorted_first_values.end(), value);
+          if (iter != sorted_first_values.begin()) {
+            GGsize range_id = sorted_ranges[static_cast<GGsize>(iter - sorted_first_values.begin()) - 1];
+            if (is_in_range(value, label_ranges[range_id])) labels[i] = static_cast<L>(range_id);
+          }
+        }
+        else {
+          // Overlapping ranges, last matching range in file wins
+          for (GGsize r = kNumberOfRanges; r > 0; --r) {
+            if (is_in_range(value, label_ranges[r-1])) {
+              labels[i] = static_cast<L>(r-1);
+              break;
+            }
+          }
+        }
+        chunk_converted &= (labels[i] != std::numeric_limits<L>::max());
+      }
+      if (!chunk_converted) all_converted = false;
+    });
+  }
+
+  // Checking if all voxels converted
+  if (all_converted) {
+    GGcout("GGEMSVoxelizedSolid", "FillLabelData", 2) << "All your voxels are converted to label..." << GGendl;
+  }
+  else {
+    GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "FillLabelData", "Errors(s) in the range data file!!!");
+  }
+
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Uploading same labels on each device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Allocating memory on OpenCL device
+    label_data_[d] = opencl_manager.Allocate(nullptr, number_of_voxels_ * sizeof(L), d, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
+
+    // Get pointer on OpenCL device
+    L* label_data_device = opencl_manager.GetDeviceBuffer<L>(label_data_[d], CL_TRUE, CL_MAP_WRITE, number_of_voxels_ * sizeof(L), d);
+
+    std::copy(labels.begin(), labels.end(), label_data_device);
 
     // Release the pointer
     opencl_manager.ReleaseDeviceBuffer(label_data_[d], label_data_device, d);
-
-    // Checking if all voxels converted
-    if (all_converted) {
-      GGcout("GGEMSVoxelizedSolid", "ConvertImageToLabel", 2) << "All your voxels are converted to label..." << GGendl;
-    }
-    else {
-      GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "ConvertImageToLabel", "Errors(s) in the range data file!!!");
-    }
   }
 }
 
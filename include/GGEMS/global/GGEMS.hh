@@ -43,6 +43,8 @@
 
 #include "GGEMS/tools/GGEMSTypes.hh"
 
+class GGEMSProgressBar;
+
 /*!
   \class GGEMS
   \brief GGEMS class managing the complete simulation
@@ -96,10 +98,20 @@ class GGEMS_EXPORT GGEMS
     void Initialize(GGuint const& seed = 0);
 
     /*!
-      \fn void Run(void)
-      \brief run the GGEMS simulation
+      \fn void Run(GGuint const& seed = 0)
+      \param seed - new seed of random streams, 0 to continue streams of previous run
+      \brief run the GGEMS simulation, it could be called several times after initialization. Sources modified since previous run are updated, tallies are cleaned except if tally accumulation is activated
+    */
+    void Run(GGuint const& seed = 0);
+
+    /*!
+      \fn void RunGantrySweep(GGsize const& number_of_projections, GGfloat const& angle_step, std::string const& unit = "deg")
+      \param number_of_projections - number of projections
+      \param angle_step - rotation of gantry between two projections around Z axis
+      \param unit - unit of the angle
+      \brief run a projection for each gantry angle reusing initialized simulation. Sources and detector systems rotate around isocenter, detector counts are cleaned and saved for each projection only, dose is accumulated over the whole sweep
     */
-    void Run(void);
+    void RunGantrySweep(GGsize const& number_of_projections, GGfloat const& angle_step, std::string const& unit = "deg");
 
     /*!
       \fn void SetOpenCLVerbose(bool const& is_opencl_verbose)
@@ -193,6 +205,48 @@ class GGEMS_EXPORT GGEMS
     */
     inline GGint GetParticleTrackingID(void) const {return particle_tracking_id_;}
 
+    /*!
+      \fn void SetAsynchronousStepping(bool const& is_asynchronous_stepping)
+      \param is_asynchronous_stepping - flag for asynchronous stepping
+      \brief enqueue the kernels of a step back to back without waiting the device, the host synchronizes only when reading the alive status. Disable it to wait for the device after each step (debugging kernels)
+    */
+    void SetAsynchronousStepping(bool const& is_asynchronous_stepping);
+
+    /*!
+      \fn void SetParticleCompaction(bool const& is_particle_compaction)
+      \param is_particle_compaction - flag for compaction of particles
+      \brief pack alive particles at the beginning of the particle buffer after each step, so the next step is launched only on alive particles. Not used with tracking or OpenGL, particle index is not kept
+    */
+    void SetParticleCompaction(bool const& is_particle_compaction);
+
+    /*!
+      \fn void SetRandomEngine(std::string const& random_engine)
+      \param random_engine - name of random engine, 'jkiss' or 'philox'
+      \brief select the random engine of OpenCL kernels. JKISS is the default and reproduces previous results, Philox keeps only a draw counter per particle in device memory
+    */
+    void SetRandomEngine(std::string const& random_engine);
+
+    /*!
+      \fn void SetDynamicLoadBalancing(bool const& is_dynamic_load_balancing)
+      \param is_dynamic_load_balancing - flag for dynamic load balancing
+      \brief each device pulls the next batch of a source from a shared counter until all particles are simulated, faster devices simulate more batchs. Device balancing fractions are ignored
+    */
+    void SetDynamicLoadBalancing(bool const& is_dynamic_load_balancing);
+
+    /*!
+      \fn void SetTallyAccumulation(bool const& is_tally_accumulation)
+      \param is_tally_accumulation - flag for tally accumulation
+      \brief keep tallies of previous runs, otherwize tallies are cleaned before each new run
+    */
+    void SetTallyAccumulation(bool const& is_tally_accumulation);
+
+    /*!
+      \fn void SetParticleBatchSize(GGsize const& particle_batch_size)
+      \param particle_batch_size - maximum number of particles in a batch, 0 for a size computed from device memory
+      \brief set the capacity of particle and random buffers on each device
+    */
+    void SetParticleBatchSize(GGsize const& particle_batch_size);
+
   private:
     /*!
       \fn void PrintBanner(void) const
@@ -207,6 +261,34 @@ class GGEMS_EXPORT GGEMS
     */
     void RunOnDevice(GGsize const& thread_index);
 
+    /*!
+      \fn void RunOnAllDevices(void)
+      \brief simulate all particles of all sources, a thread is launched for each OpenCL device
+    */
+    void RunOnAllDevices(void);
+
+    /*!
+      \fn GGsize ComputeParticleBatchSize(void) const
+      \return number of particles fitting in memory of all activated devices
+      \brief compute the capacity of particle and random buffers from free memory on activated devices
+    */
+    GGsize ComputeParticleBatchSize(void) const;
+
+    /*!
+      \fn void PrepareRun(void)
+      \brief update sources and clean tallies if a previous run has been done
+    */
+    void PrepareRun(void);
+
+    /*!
+      \fn void RunBatch(GGsize const& source_index, GGsize const& thread_index, GGsize const& number_of_particles)
+      \param source_index - index of the source
+      \param thread_index - index of the thread
+      \param number_of_particles - number of particles in batch
+      \brief generate and track a batch of particles until all particles are dead
+    */
+    void RunBatch(GGsize const& source_index, GGsize const& thread_index, GGsize const& number_of_particles);
+
   private: // Global simulation parameters
     bool is_opencl_verbose_; /*!< Flag for OpenCL verbosity */
     bool is_material_database_verbose_; /*!< Flag for material database verbosity */
@@ -219,6 +301,13 @@ class GGEMS_EXPORT GGEMS
     bool is_tracking_verbose_; /*!< Flag for tracking verbosity */
     bool is_profiling_verbose_; /*!< Flag for kernel time verbosity */
     GGint particle_tracking_id_; /*!< Particle if for tracking */
+    bool is_asynchronous_stepping_; /*!< Flag for asynchronous stepping, true by default */
+    bool is_particle_compaction_; /*!< Flag for compaction of particles between steps */
+    bool is_dynamic_load_balancing_; /*!< Flag for batchs pulled by devices from a shared counter */
+    GGEMSProgressBar* progress_bar_; /*!< Progress bar of current run, shared by device threads */
+    bool is_tally_accumulation_; /*!< Flag keeping tallies between runs */
+    GGsize number_of_runs_; /*!< Number of runs done since initialization */
+    GGsize particle_batch_size_; /*!< Capacity of particle buffers, 0 if computed from device memory */
 };
 
 /*!
@@ -325,10 +414,69 @@ extern "C" GGEMS_EXPORT void set_profiling_ggems(GGEMS* ggems, bool const is_pro
 extern "C" GGEMS_EXPORT void set_tracking_ggems(GGEMS* ggems, bool const is_tracking_verbose, GGint const particle_id_tracking);
 
 /*!
-  \fn void run_ggems(GGEMS* ggems)
+  \fn void set_asynchronous_stepping_ggems(GGEMS* ggems, bool const is_asynchronous_stepping)
+  \param ggems - pointer to GGEMS
+  \param is_asynchronous_stepping - flag on asynchronous stepping
+  \brief Set the asynchronous stepping
+*/
+extern "C" GGEMS_EXPORT void set_asynchronous_stepping_ggems(GGEMS* ggems, bool const is_asynchronous_stepping);
+
+/*!
+  \fn void set_particle_compaction_ggems(GGEMS* ggems, bool const is_particle_compaction)
+  \param ggems - pointer to GGEMS
+  \param is_particle_compaction - flag on compaction of particles
+  \brief Set the compaction of particles
+*/
+extern "C" GGEMS_EXPORT void set_particle_compaction_ggems(GGEMS* ggems, bool const is_particle_compaction);
+
+/*!
+  \fn void set_random_engine_ggems(GGEMS* ggems, char const* random_engine)
+  \param ggems - pointer on ggems
+  \param random_engine - name of random engine
+  \brief Set the random engine used by OpenCL kernels
+*/
+extern "C" GGEMS_EXPORT void set_random_engine_ggems(GGEMS* ggems, char const* random_engine);
+
+/*!
+  \fn void set_dynamic_load_balancing_ggems(GGEMS* ggems, bool const is_dynamic_load_balancing)
   \param ggems - pointer to GGEMS
+  \param is_dynamic_load_balancing - flag on dynamic load balancing
+  \brief Set the dynamic load balancing between devices
+*/
+extern "C" GGEMS_EXPORT void set_dynamic_load_balancing_ggems(GGEMS* ggems, bool const is_dynamic_load_balancing);
+
+/*!
+  \fn void set_tally_accumulation_ggems(GGEMS* ggems, bool const is_tally_accumulation)
+  \param ggems - pointer to GGEMS
+  \param is_tally_accumulation - flag for tally accumulation
+  \brief Keep tallies between runs
+*/
+extern "C" GGEMS_EXPORT void set_tally_accumulation_ggems(GGEMS* ggems, bool const is_tally_accumulation);
+
+/*!
+  \fn void set_particle_batch_size_ggems(GGEMS* ggems, GGsize const particle_batch_size)
+  \param ggems - pointer to GGEMS
+  \param particle_batch_size - maximum number of particles in a batch, 0 for automatic size
+  \brief Set the capacity of particle buffers
+*/
+extern "C" GGEMS_EXPORT void set_particle_batch_size_ggems(GGEMS* ggems, GGsize const particle_batch_size);
+
+/*!
+  \fn void run_ggems(GGEMS* ggems, GGuint const seed)
+  \param ggems - pointer to GGEMS
+  \param seed - new seed of random streams, 0 to continue streams of previous run
   \brief Run the GGEMS simulation
 */
-extern "C" GGEMS_EXPORT void run_ggems(GGEMS* ggems);
+extern "C" GGEMS_EXPORT void run_ggems(GGEMS* ggems, GGuint const seed);
+
+/*!
+  \fn void run_gantry_sweep_ggems(GGEMS* ggems, GGsize const number_of_projections, GGfloat const angle_step, char const* unit)
+  \param ggems - pointer to GGEMS
+  \param number_of_projections - number of projections
+  \param angle_step - rotation of gantry between two projections
+  \param unit - unit of the angle
+  \brief Run GGEMS simulation for each gantry angle
+*/
+extern "C" GGEMS_EXPORT void run_gantry_sweep_ggems(GGEMS* ggems, GGsize const number_of_projections, GGfloat const angle_step, char const* unit);
 
 #endif // End of GUARD_GGEMS_GLOBAL_GGEMS_HH
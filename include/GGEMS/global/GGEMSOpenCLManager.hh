@@ -45,6 +45,10 @@
 typedef std::unordered_map<std::string, std::string> VendorUMap; /*!< Alias to OpenCL vendors */
 
 #define KERNEL_NOT_COMPILED 0x100000000 /*!< value if OpenCL kernel is not compiled */
+#define WORK_GROUP_TUNING_MIN_SIZE 16 /*!< Smallest candidate work group size during auto-tuning */
+#define WORK_GROUP_TUNING_MAX_SIZE 1024 /*!< Largest candidate work group size during auto-tuning */
+#define WORK_GROUP_TUNING_LAUNCHES 3 /*!< Number of timed launches for each candidate work group size */
+#define WORK_GROUP_TUNING_MIN_WORK_ITEMS 16384 /*!< Minimum number of work-items of a timed launch, smaller launches are dominated by overhead */
 
 /*!
   \struct ComputingDevice_t
@@ -74,6 +78,22 @@ typedef struct ComputingDevice_t
   }
 } ComputingDevice; /*!< Using C convention name of struct to C++ (_t deletion) */
 
+/*!
+  \struct KernelWorkGroupSize_t
+  \brief Structure storing work group size of a kernel on a device, and timings of candidate sizes during auto-tuning
+*/
+typedef struct KernelWorkGroupSize_t
+{
+  GGsize work_group_size_; /*!< Work group size used to launch the kernel */
+  bool is_tuned_; /*!< True if work group size is selected, by tuning or from kernel cache */
+  std::vector<GGsize> candidates_; /*!< Candidate work group sizes, multiples of preferred size */
+  std::vector<GGdouble> timings_; /*!< Best time by work-item in ns for each candidate */
+  GGsize number_of_timings_; /*!< Number of timed launches */
+  std::string cache_filename_; /*!< File storing tuned work group size in kernel cache, empty if cache disabled */
+} KernelWorkGroupSize; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+typedef std::unordered_map<cl::Kernel*, KernelWorkGroupSize> KernelWorkGroupSizeUMap; /*!< Alias to work group size of each kernel */
+
 /*!
   \class GGEMSOpenCLManager
   \brief Singleton class storing all informations about OpenCL and managing GPU/CPU devices, contexts, kernels, command queues and events. In GGEMS the strategy is 1 context = 1 device.
@@ -232,6 +252,53 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     GGsize GetBestWorkItem(GGsize const& number_of_elements) const;
 
+    /*!
+      \fn GGsize GetBestWorkItem(GGsize const& number_of_elements, GGsize const& work_group_size) const
+      \param number_of_elements - number of elements for the kernel computation
+      \param work_group_size - work group size of the launched kernel
+      \return best number of work item
+      \brief get the best number of work item, multiple of the work group size of a kernel
+    */
+    GGsize GetBestWorkItem(GGsize const& number_of_elements, GGsize const& work_group_size) const;
+
+    /*!
+      \fn void SetWorkGroupTuning(bool const& is_work_group_tuning)
+      \param is_work_group_tuning - flag activating auto-tuning of work group size
+      \brief time a few work group sizes for each kernel on each device during first launches, and keep the fastest one
+    */
+    void SetWorkGroupTuning(bool const& is_work_group_tuning);
+
+    /*!
+      \fn GGsize GetKernelWorkGroupSize(cl::Kernel* kernel) const
+      \param kernel - pointer on kernel on a device
+      \return work group size to launch the kernel
+      \brief get the tuned work group size of a kernel, or the candidate to time if tuning is running
+    */
+    GGsize GetKernelWorkGroupSize(cl::Kernel* kernel) const;
+
+    /*!
+      \fn void TuneKernelWorkGroupSize(cl::Kernel* kernel, cl::Event& event, GGsize const& number_of_work_items)
+      \param kernel - pointer on kernel on a device
+      \param event - event of the kernel launched with GetKernelWorkGroupSize
+      \param number_of_work_items - number of launched work-items
+      \brief time the launch of a kernel if tuning is running, the kernel is waited only during tuning
+    */
+    void TuneKernelWorkGroupSize(cl::Kernel* kernel, cl::Event& event, GGsize const& number_of_work_items);
+
+    /*!
+      \fn void SetParticleCapacity(GGsize const& particle_capacity)
+      \param particle_capacity - number of particles stored in particle and random buffers
+      \brief set the capacity of particle buffers, rounded to a multiple of work group size, before compiling kernels using particle buffers
+    */
+    void SetParticleCapacity(GGsize const& particle_capacity);
+
+    /*!
+      \fn inline GGsize GetParticleCapacity(void) const
+      \return capacity of particle buffers
+      \brief Get the number of particles stored in particle and random buffers on each device
+    */
+    inline GGsize GetParticleCapacity(void) const {return particle_capacity_;}
+
     /*!
       \fn inline GGsize GetIndexOfActivatedDevice(GGsize const& thread_index) const
       \param thread_index - index of the thread (= activated device index)
@@ -317,6 +384,20 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     void CompileKernel(std::string const& kernel_filename, std::string const& kernel_name, cl::Kernel** kernel_list, char* const custom_options = nullptr, char* const additional_options = nullptr);
 
+    /*!
+      \fn void SetKernelCacheDirectory(std::string const& directory)
+      \param directory - directory storing compiled OpenCL program binaries, empty string to disable the cache
+      \brief set the directory of the on-disk kernel binary cache
+    */
+    void SetKernelCacheDirectory(std::string const& directory);
+
+    /*!
+      \fn inline std::string GetKernelCacheDirectory(void) const
+      \return directory storing compiled OpenCL program binaries
+      \brief get the directory of the on-disk kernel binary cache
+    */
+    inline std::string GetKernelCacheDirectory(void) const {return kernel_cache_directory_;}
+
     /*!
       \return the pointer on host memory on write/read mode
       \brief Get the device pointer on host to write on it. ReleaseDeviceBuffer must be used after this method!!!
@@ -340,6 +421,16 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     template <typename T>
     void ReleaseDeviceBuffer(cl::Buffer* const device_ptr, T* host_ptr, GGsize const& thread_index);
 
+    /*!
+      \fn template <typename T> void ReduceBuffers(cl::Buffer** buffers, GGsize const& size)
+      \tparam T - type of buffer elements
+      \param buffers - buffer on each activated device
+      \param size - size of each buffer in bytes
+      \brief Sum a buffer of all activated devices in buffer of first device, buffers of other devices are cleaned after the sum so a new reduction does not count them twice
+    */
+    template <typename T>
+    void ReduceBuffers(cl::Buffer** buffers, GGsize const& size);
+
     /*!
       \fn cl::Buffer* Allocate(void* host_ptr, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags, std::string const& class_name = "Undefined")
       \param host_ptr - pointer to buffer in host memory
@@ -427,6 +518,61 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     GGsize CheckKernel(std::string const& kernel_name, std::string const& compilation_options) const;
 
+    /*!
+      \fn void ReadKernelSources(std::string const& filename, std::string& sources, std::vector<std::string>& read_files) const
+      \param filename - kernel or header filename
+      \param sources - string storing the content of the file and of all the included headers
+      \param read_files - list of files already read
+      \brief read a kernel file and recursively all the headers it includes, used to key the kernel binary cache and to find kernels using particle buffers
+    */
+    void ReadKernelSources(std::string const& filename, std::string& sources, std::vector<std::string>& read_files) const;
+
+    /*!
+      \fn std::string GetKernelCacheFilename(std::string const& kernel_name, std::string const& sources, std::string const& compilation_options, GGsize const& thread_index) const
+      \param kernel_name - name of the kernel
+      \param sources - kernel source code with all included headers
+      \param compilation_options - arguments of compilation
+      \param thread_index - index of the thread (= activated device index)
+      \return filename of the program binary in the kernel cache
+      \brief compute the cache filename from a hash of sources, options and device/driver identity
+    */
+    std::string GetKernelCacheFilename(std::string const& kernel_name, std::string const& sources, std::string const& compilation_options, GGsize const& thread_index) const;
+
+    /*!
+      \fn bool LoadKernelBinary(std::string const& filename, std::string const& compilation_options, GGsize const& thread_index, cl::Program& program)
+      \param filename - filename of the program binary
+      \param compilation_options - arguments of compilation
+      \param thread_index - index of the thread (= activated device index)
+      \param program - OpenCL program built from the binary
+      \return true if the program is loaded and built from the cache
+      \brief load a program binary from the kernel cache
+    */
+    bool LoadKernelBinary(std::string const& filename, std::string const& compilation_options, GGsize const& thread_index, cl::Program& program);
+
+    /*!
+      \fn void SaveKernelBinary(std::string const& filename, cl::Program& program) const
+      \param filename - filename of the program binary
+      \param program - OpenCL program built from source
+      \brief store a program binary in the kernel cache
+    */
+    void SaveKernelBinary(std::string const& filename, cl::Program& program) const;
+
+    /*!
+      \fn void InitializeKernelWorkGroupSize(cl::Kernel* kernel, GGsize const& thread_index, std::string const& cache_filename)
+      \param kernel - pointer on compiled kernel
+      \param thread_index - index of the thread (= activated device index)
+      \param cache_filename - filename of the program binary in the kernel cache, empty if cache disabled
+      \brief compute candidate work group sizes of a kernel, and load tuned size from kernel cache
+    */
+    void InitializeKernelWorkGroupSize(cl::Kernel* kernel, GGsize const& thread_index, std::string const& cache_filename);
+
+    /*!
+      \fn void SaveKernelWorkGroupSize(KernelWorkGroupSize const& kernel_work_group_size) const
+      \param kernel_work_group_size - tuned work group size of a kernel
+      \brief store a tuned work group size in the kernel cache
+    */
+    void SaveKernelWorkGroupSize(KernelWorkGroupSize const& kernel_work_group_size) const;
+
     /*!
       \fn bool IsDoublePrecision(GGsize const& device_index) const
       \param device_index - index of the device
@@ -529,6 +675,7 @@ class GGEMS_EXPORT GGEMSOpenCLManager
 
     // Custom OpenCL members
     GGsize work_group_size_; /*!< Work group size by GGEMS, here 64 */
+    GGsize particle_capacity_; /*!< Number of particles in particle and random buffers, MAXIMUM_PARTICLES in kernels */
     VendorUMap vendors_; /*!< Storing vendor name and an alias */
 
     // OpenCL compilation options
@@ -540,6 +687,12 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     // OpenCL kernels
     std::vector<cl::Kernel*> kernels_; /*!< List of kernels for each device */
     std::vector<std::string> kernel_compilation_options_; /*!< List of compilation options for kernel */
+    std::vector<GGsize> kernel_particle_capacities_; /*!< Capacity of particle buffers for kernel, 0 if kernel does not use particle buffers */
+    std::string kernel_cache_directory_; /*!< Directory storing compiled program binaries, empty if cache disabled */
+
+    // Work group size of kernels
+    bool is_work_group_tuning_; /*!< Flag for auto-tuning of work group size of kernels */
+    KernelWorkGroupSizeUMap kernel_work_group_sizes_; /*!< Work group size of each kernel on each device */
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -585,6 +738,32 @@ void GGEMSOpenCLManager::ReleaseDeviceBuffer(cl::Buffer* const device_ptr, T* ho
   HandleEvent(event, message);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void GGEMSOpenCLManager::ReduceBuffers(cl::Buffer** buffers, GGsize const& size)
+{
+  GGcout("GGEMSOpenCLManager", "ReduceBuffers", 4) << "Summing buffers of activated devices on first device..." << GGendl;
+
+  GGsize number_of_elements = size / sizeof(T);
+  T* first_device_ptr = nullptr;
+
+  for (GGsize d = 1; d < computing_devices_.size(); ++d) {
+    if (!first_device_ptr) first_device_ptr = GetDeviceBuffer<T>(buffers[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, size, 0);
+
+    T* device_ptr = GetDeviceBuffer<T>(buffers[d], CL_TRUE, CL_MAP_READ, size, d);
+    for (GGsize i = 0; i < number_of_elements; ++i) first_device_ptr[i] += device_ptr[i];
+    ReleaseDeviceBuffer(buffers[d], device_ptr, d);
+
+    // Tally is now stored on first device only
+    CleanBuffer(buffers[d], size, d);
+  }
+
+  if (first_device_ptr) ReleaseDeviceBuffer(buffers[0], first_device_ptr, 0);
+}
+
 /*!
   \fn GGEMSOpenCLManager* get_instance_ggems_opencl_manager(void)
   \return the pointer on the singleton
@@ -631,4 +810,20 @@ extern "C" GGEMS_EXPORT void clean_opencl_manager(GGEMSOpenCLManager* opencl_man
 */
 extern "C" GGEMS_EXPORT void set_device_balancing_opencl_manager(GGEMSOpenCLManager* opencl_manager, char const* device_balancing);
 
+/*!
+  \fn void set_kernel_cache_directory_opencl_manager(GGEMSOpenCLManager* opencl_manager, char const* directory)
+  \param opencl_manager - pointer on the singleton
+  \param directory - directory storing compiled OpenCL program binaries, empty string to disable the cache
+  \brief set the directory of the on-disk kernel binary cache
+*/
+extern "C" GGEMS_EXPORT void set_kernel_cache_directory_opencl_manager(GGEMSOpenCLManager* opencl_manager, char const* directory);
+
+/*!
+  \fn void set_work_group_tuning_opencl_manager(GGEMSOpenCLManager* opencl_manager, bool const is_work_group_tuning)
+  \param opencl_manager - pointer on the singleton
+  \param is_work_group_tuning - flag activating auto-tuning of work group size
+  \brief activate auto-tuning of work group size of kernels
+*/
+extern "C" GGEMS_EXPORT void set_work_group_tuning_opencl_manager(GGEMSOpenCLManager* opencl_manager, bool const is_work_group_tuning);
+
 #endif // GUARD_GGEMS_GLOBAL_GGEMSOPENCLMANAGER_HH
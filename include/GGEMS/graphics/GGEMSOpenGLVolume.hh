@@ -145,13 +145,14 @@ class GGEMS_EXPORT GGEMSOpenGLVolume
     void SetColorName(std::string const& color);
 
     /*!
-      \fn void SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels)
+      \fn void SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels, GGsize const& label_size)
       \param materials - list of materials selected during simulation
       \param label - label data corresponding to material
       \param number_of_voxels - number of voxels
+      \param label_size - size of a label element in bytes, GGuchar or GGushort
       \brief Set material list and labels, to find color associated to material
     */
-    void SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels);
+    void SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels, GGsize const& label_size);
 
     /*!
       \fn void SetMaterial(std::string const& material_name)
@@ -216,7 +217,7 @@ class GGEMS_EXPORT GGEMSOpenGLVolume
     GLfloat update_angle_z_; /*!< Angle after translation, volume rotate around isocenter */
 
     MaterialRGBColorUMap material_rgb_; /*!< Color of material */
-    GGuchar* label_; /*!< Label for material */
+    GGushort* label_; /*!< Label for material */
     std::vector<std::string> material_names_; /*!< Name of material */
     MaterialVisibleUMap material_visible_; /*!< Visibily of material */
 
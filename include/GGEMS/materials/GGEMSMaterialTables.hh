@@ -45,35 +45,35 @@ typedef struct GGEMSMaterialTables_t
   GGsize total_number_of_chemical_elements_; /*!< Total number of chemical elements */
 
   // Infos by materials
-  GGsize number_of_chemical_elements_[255]; /*!< Number of chemical elements in a single material */
-  GGfloat density_of_material_[255]; /*!< Density of material in g/cm3 */
-  GGfloat number_of_atoms_by_volume_[255]; /*!< Number of atoms by volume */
-  GGfloat number_of_electrons_by_volume_[255]; /*!< Number of electrons by volume */
-  GGfloat mean_excitation_energy_[255]; /*!< Mean of excitation energy */
-  GGfloat log_mean_excitation_energy_[255]; /*!< Log of mean of excitation energy */
-  GGfloat radiation_length_[255]; /*!< Radiation length */
-  GGfloat x0_density_[255]; /*!< x0 density correction */
-  GGfloat x1_density_[255]; /*!< x1 density correction */
-  GGfloat d0_density_[255]; /*!< d0 density correction */
-  GGfloat c_density_[255]; /*!< c density correction */
-  GGfloat a_density_[255]; /*!< a density correction */
-  GGfloat m_density_[255]; /*!< m density correction */
-  GGfloat f1_fluct_[255]; /*!< f1 energy loss fluctuation model */
-  GGfloat f2_fluct_[255]; /*!< f2 energy loss fluctuation model */
-  GGfloat energy0_fluct_[255]; /*!< energy 0 energy loss fluctuation model */
-  GGfloat energy1_fluct_[255]; /*!< energy 1 energy loss fluctuation model */
-  GGfloat energy2_fluct_[255]; /*!< energy 2 energy loss fluctuation model */
-  GGfloat log_energy1_fluct_[255]; /*!< log of energy 0 energy loss fluctuation model */
-  GGfloat log_energy2_fluct_[255]; /*!< log of energy 1 energy loss fluctuation model */
-  GGfloat photon_energy_cut_[255]; /*!< Photon energy cut */
-  GGfloat electron_energy_cut_[255]; /*!< Electron energy cut */
-  GGfloat positron_energy_cut_[255]; /*!< Positron energy cut */
+  GGsize number_of_chemical_elements_[MAXIMUM_MATERIALS]; /*!< Number of chemical elements in a single material */
+  GGfloat density_of_material_[MAXIMUM_MATERIALS]; /*!< Density of material in g/cm3 */
+  GGfloat number_of_atoms_by_volume_[MAXIMUM_MATERIALS]; /*!< Number of atoms by volume */
+  GGfloat number_of_electrons_by_volume_[MAXIMUM_MATERIALS]; /*!< Number of electrons by volume */
+  GGfloat mean_excitation_energy_[MAXIMUM_MATERIALS]; /*!< Mean of excitation energy */
+  GGfloat log_mean_excitation_energy_[MAXIMUM_MATERIALS]; /*!< Log of mean of excitation energy */
+  GGfloat radiation_length_[MAXIMUM_MATERIALS]; /*!< Radiation length */
+  GGfloat x0_density_[MAXIMUM_MATERIALS]; /*!< x0 density correction */
+  GGfloat x1_density_[MAXIMUM_MATERIALS]; /*!< x1 density correction */
+  GGfloat d0_density_[MAXIMUM_MATERIALS]; /*!< d0 density correction */
+  GGfloat c_density_[MAXIMUM_MATERIALS]; /*!< c density correction */
+  GGfloat a_density_[MAXIMUM_MATERIALS]; /*!< a density correction */
+  GGfloat m_density_[MAXIMUM_MATERIALS]; /*!< m density correction */
+  GGfloat f1_fluct_[MAXIMUM_MATERIALS]; /*!< f1 energy loss fluctuation model */
+  GGfloat f2_fluct_[MAXIMUM_MATERIALS]; /*!< f2 energy loss fluctuation model */
+  GGfloat energy0_fluct_[MAXIMUM_MATERIALS]; /*!< energy 0 energy loss fluctuation model */
+  GGfloat energy1_fluct_[MAXIMUM_MATERIALS]; /*!< energy 1 energy loss fluctuation model */
+  GGfloat energy2_fluct_[MAXIMUM_MATERIALS]; /*!< energy 2 energy loss fluctuation model */
+  GGfloat log_energy1_fluct_[MAXIMUM_MATERIALS]; /*!< log of energy 0 energy loss fluctuation model */
+  GGfloat log_energy2_fluct_[MAXIMUM_MATERIALS]; /*!< log of energy 1 energy loss fluctuation model */
+  GGfloat photon_energy_cut_[MAXIMUM_MATERIALS]; /*!< Photon energy cut */
+  GGfloat electron_energy_cut_[MAXIMUM_MATERIALS]; /*!< Electron energy cut */
+  GGfloat positron_energy_cut_[MAXIMUM_MATERIALS]; /*!< Positron energy cut */
 
   // Infos by chemical elements by materials
-  GGsize index_of_chemical_elements_[255]; /*!< Index to chemical element by material */
-  GGuchar atomic_number_Z_[255*32]; /*!< Atomic number Z by chemical elements */
-  GGfloat atomic_number_density_[255*32]; /*!< Atomic number density : fraction of element in material * density * Avogadro / Atomic mass */
-  GGfloat mass_fraction_[255*32]; /*!< Mass fraction of element in material */
+  GGsize index_of_chemical_elements_[MAXIMUM_MATERIALS]; /*!< Index to chemical element by material */
+  GGuchar atomic_number_Z_[MAXIMUM_MATERIALS*32]; /*!< Atomic number Z by chemical elements */
+  GGfloat atomic_number_density_[MAXIMUM_MATERIALS*32]; /*!< Atomic number density : fraction of element in material * density * Avogadro / Atomic mass */
+  GGfloat mass_fraction_[MAXIMUM_MATERIALS*32]; /*!< Mass fraction of element in material */
 } GGEMSMaterialTables; /*!< Using C convention name of struct to C++ (_t deletion) */
 
 #endif // GUARD_GGEMS_MATERIALS_GGEMSMATERIALSTABLE_HH
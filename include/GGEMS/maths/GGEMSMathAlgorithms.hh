@@ -73,6 +73,23 @@ inline GGint BinarySearchLeft(GGfloat const key, GGfloat const* array, GGint con
   return min;
 }
 
+#ifdef __OPENCL_C_VERSION__
+/*!
+  \fn inline GGint LogScaleIndex(GGfloat const key, GGfloat const log_min, GGfloat const inverse_log_step, GGint const size)
+  \param key - value to find
+  \param log_min - log of the first value of the log scale table
+  \param inverse_log_step - inverse of log step between 2 values of the table
+  \param size - size of table, number of elements
+  \return index of key value in a log scale table
+  \brief Compute directly the index of the key value in a log scale table, same convention than BinarySearchLeft (lower bin in [0, size-2])
+*/
+inline GGint LogScaleIndex(GGfloat const key, GGfloat const log_min, GGfloat const inverse_log_step, GGint const size)
+{
+  GGfloat index = (log(key) - log_min) * inverse_log_step;
+  return convert_int(fmin(fmax(index, 0.0f), (GGfloat)(size - 2)));
+}
+#endif
+
 /*!
   \fn inline GGfloat LinearInterpolation(GGfloat xa, GGfloat ya, GGfloat xb, GGfloat yb, GGfloat x)
   \param xa - Coordinate x of point A
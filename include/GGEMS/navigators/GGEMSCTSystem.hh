@@ -240,6 +240,14 @@ extern "C" GGEMS_EXPORT void set_save_ggems_ct_system(GGEMSCTSystem* ct_system,
 */
 extern "C" GGEMS_EXPORT void store_scatter_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_scatter);
 
+/*!
+  \fn void enable_solid_table_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_solid_table)
+  \param ct_system - pointer on ct system
+  \param is_solid_table - flag to navigate all modules with a single table of solids
+  \brief Set solid table flag
+*/
+extern "C" GGEMS_EXPORT void enable_solid_table_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_solid_table);
+
 /*!
   \fn void set_visible_ggems_ct_system(GGEMSCTSystem* ct_system, bool const flag)
   \param ct_system - pointer on ct scanner
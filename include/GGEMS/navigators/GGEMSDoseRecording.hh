@@ -43,6 +43,7 @@ typedef struct GGEMSDoseRecording_t
 {
   cl::Buffer** edep_; /*!< Buffer storing energy deposit on OpenCL device */
   cl::Buffer** edep_squared_; /*!< Buffer storing energy deposit squared on OpenCL device */
+  cl::Buffer** edep_batch_; /*!< Buffer storing energy deposit of current batch on OpenCL device, batch uncertainty only */
   cl::Buffer** hit_; /*!< Buffer storing hit on OpenCL device */
   cl::Buffer** photon_tracking_; /*!< Buffer storing photon tracking on OpenCL device */
   cl::Buffer** dose_; /*!< Buffer storing dose in gray (Gy) */
@@ -83,13 +84,145 @@ inline void dose_photon_tracking(global GGEMSDoseParams* dose_params, global GGi
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef DOSE_LOCAL_TALLY_SIZE
+#define DOSE_LOCAL_TALLY_SIZE 512 /*!< Number of dosels cached in local memory by a work-group */
+#endif
+
+#define DOSE_LOCAL_TALLY_PROBES 4 /*!< Number of slots tested in local tally before recording in global memory */
+
+/*!
+  \struct GGEMSDoseLocalTally_t
+  \brief Dosels cached in local memory of a work-group, flushed to global tallies at the end of kernel
+*/
+typedef struct GGEMSDoseLocalTally_t
+{
+  GGint dosel_id_[DOSE_LOCAL_TALLY_SIZE]; /*!< Index of dosel stored in slot, -1 if free */
+  GGDosiTallyType edep_[DOSE_LOCAL_TALLY_SIZE]; /*!< Energy deposit in slot */
+  GGDosiTallyType edep_squared_[DOSE_LOCAL_TALLY_SIZE]; /*!< Energy deposit squared in slot */
+  GGint hit_[DOSE_LOCAL_TALLY_SIZE]; /*!< Hit in slot */
+} GGEMSDoseLocalTally; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 /*!
-  \fn void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+  \fn inline void AtomicAddLocal(volatile local GGDosiTallyType* address, GGDosiTallyType val)
+  \param address - address of pointer in local memory where the value is added
+  \param val - value to add in tally unit
+  \brief atomic addition in local memory, fixed-point, float or double precision
+*/
+inline void AtomicAddLocal(volatile local GGDosiTallyType* address, GGDosiTallyType val)
+{
+  #if defined(DOSIMETRY_FIXED_POINT) && defined(cl_khr_int64_base_atomics)
+  atom_add(address, val);
+  #elif defined(DOSIMETRY_FIXED_POINT)
+  #ifdef __ENDIAN_LITTLE__
+  volatile local GGuint* low_word = (volatile local GGuint*)address;
+  volatile local GGuint* high_word = low_word + 1;
+  #else
+  volatile local GGuint* high_word = (volatile local GGuint*)address;
+  volatile local GGuint* low_word = high_word + 1;
+  #endif
+
+  GGuint low = (GGuint)val;
+  GGuint high = (GGuint)(val >> 32);
+
+  GGuint previous_low = atomic_add(low_word, low);
+  if (previous_low + low < previous_low) ++high;
+  if (high) atomic_add(high_word, high);
+  #elif defined(DOSIMETRY_DOUBLE_PRECISION)
+  union {
+    GGulong  u64;
+    GGdouble f64;
+  } next, expected, current;
+
+  current.f64 = *address;
+
+  do {
+    expected.f64 = current.f64;
+    next.f64     = expected.f64 + val;
+    current.u64  = atom_cmpxchg((volatile local GGulong*)address, expected.u64, next.u64);
+  } while(current.u64 != expected.u64);
+  #else
+  union {
+    GGuint  u32;
+    GGfloat f32;
+  } next, expected, current;
+
+  current.f32 = *address;
+
+  do {
+    expected.f32 = current.f32;
+    next.f32     = expected.f32 + val;
+    current.u32  = atomic_cmpxchg((volatile local GGuint*)address, expected.u32, next.u32);
+  } while(current.u32 != expected.u32);
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void dose_local_tally_initialize(local GGEMSDoseLocalTally* dose_local_tally)
+  \param dose_local_tally - dosels cached in local memory
+  \brief Free all slots of local tally, must be called by all work-items of the work-group
+*/
+inline void dose_local_tally_initialize(local GGEMSDoseLocalTally* dose_local_tally)
+{
+  for (GGint i = get_local_id(0); i < DOSE_LOCAL_TALLY_SIZE; i += get_local_size(0)) {
+    dose_local_tally->dosel_id_[i] = -1;
+    dose_local_tally->edep_[i] = 0;
+    dose_local_tally->edep_squared_[i] = 0;
+    dose_local_tally->hit_[i] = 0;
+  }
+
+  barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void dose_local_tally_flush(local GGEMSDoseLocalTally* dose_local_tally, global GGDosiTallyType* edep_tracking, global GGDosiTallyType* edep_squared_tracking, global GGint* hit_tracking)
+  \param dose_local_tally - dosels cached in local memory
+  \param edep_tracking - energy deposit in global memory
+  \param edep_squared_tracking - energy deposit squared in global memory
+  \param hit_tracking - hit in global memory
+  \brief Add local tally to global tallies, one global atomic by dosel and by work-group, must be called by all work-items of the work-group
+*/
+inline void dose_local_tally_flush(local GGEMSDoseLocalTally* dose_local_tally, global GGDosiTallyType* edep_tracking, global GGDosiTallyType* edep_squared_tracking, global GGint* hit_tracking)
+{
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  for (GGint i = get_local_id(0); i < DOSE_LOCAL_TALLY_SIZE; i += get_local_size(0)) {
+    GGint global_dosel_id = dose_local_tally->dosel_id_[i];
+    if (global_dosel_id < 0) continue;
+
+    if (hit_tracking) atomic_add(&hit_tracking[global_dosel_id], dose_local_tally->hit_[i]);
+    AtomicAddTally(&edep_tracking[global_dosel_id], dose_local_tally->edep_[i]);
+    if (edep_squared_tracking) AtomicAddTally(&edep_squared_tracking[global_dosel_id], dose_local_tally->edep_squared_[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiTallyType* edep_tracking, global GGDosiTallyType* edep_squared_tracking, global GGint* hit_tracking, local GGEMSDoseLocalTally* dose_local_tally, GGfloat edep, GGfloat3 const* position)
   \param dose_params - params associated to dosemap
-  \param
+  \param edep_tracking - energy deposit in global memory
+  \param edep_squared_tracking - energy deposit squared in global memory
+  \param hit_tracking - hit in global memory
+  \param dose_local_tally - dosels cached in local memory, null pointer if deposits are recorded in global memory
+  \param edep - energy deposit
+  \param position - position of energy deposit
   \brief Recording data for dosimetry
 */
-inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiTallyType* edep_tracking, global GGDosiTallyType* edep_squared_tracking, global GGint* hit_tracking, local GGEMSDoseLocalTally* dose_local_tally, GGfloat edep, GGfloat3 const* position)
 {
   // Check position of photon inside dosemap limits
   if (position->x < dose_params->border_min_xyz_.x + EPSILON6 || position->x > dose_params->border_max_xyz_.x - EPSILON6) return;
@@ -105,14 +238,28 @@ inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGD
   if (dosel_id.y < 0 || dosel_id.y >= dose_params->number_of_dosels_.y) return;
   if (dosel_id.z < 0 || dosel_id.z >= dose_params->number_of_dosels_.z) return;
 
+  // Converting deposit in tally unit once
+  GGDosiTallyType edep_tally = ConvertDoseToTally((GGDosiType)edep);
+  GGDosiTallyType edep_squared_tally = edep_squared_tracking ? ConvertSquaredDoseToTally((GGDosiType)edep*(GGDosiType)edep) : 0;
+
+  // Try to record deposit in local memory, slot is claimed by the first work-item depositing in dosel
+  if (dose_local_tally) {
+    for (GGint i = 0; i < DOSE_LOCAL_TALLY_PROBES; ++i) {
+      GGint slot = (global_dosel_id + i) % DOSE_LOCAL_TALLY_SIZE;
+      GGint slot_dosel_id = atomic_cmpxchg(&dose_local_tally->dosel_id_[slot], -1, global_dosel_id);
+      if (slot_dosel_id == -1 || slot_dosel_id == global_dosel_id) {
+        if (hit_tracking) atomic_inc(&dose_local_tally->hit_[slot]);
+        AtomicAddLocal(&dose_local_tally->edep_[slot], edep_tally);
+        if (edep_squared_tracking) AtomicAddLocal(&dose_local_tally->edep_squared_[slot], edep_squared_tally);
+        return;
+      }
+    }
+  }
+
+  // Local tally is full around this dosel, recording in global memory
   if (hit_tracking) atomic_add(&hit_tracking[global_dosel_id], 1);
-  #ifdef DOSIMETRY_DOUBLE_PRECISION
-  AtomicAddDouble(&edep_tracking[global_dosel_id], (GGDosiType)edep);
-  if (edep_squared_tracking) AtomicAddDouble(&edep_squared_tracking[global_dosel_id], (GGDosiType)edep*(GGDosiType)edep);
-  #else
-  AtomicAddFloat(&edep_tracking[global_dosel_id], (GGDosiType)edep);
-  if (edep_squared_tracking) AtomicAddFloat(&edep_squared_tracking[global_dosel_id], (GGDosiType)edep*(GGDosiType)edep);
-  #endif
+  AtomicAddTally(&edep_tracking[global_dosel_id], edep_tally);
+  if (edep_squared_tracking) AtomicAddTally(&edep_squared_tracking[global_dosel_id], edep_squared_tally);
 }
 
 #endif
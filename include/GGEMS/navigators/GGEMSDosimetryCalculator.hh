@@ -38,6 +38,8 @@
 #include "GGEMS/tools/GGEMSTypes.hh"
 #include "GGEMS/navigators/GGEMSDoseRecording.hh"
 
+#define MINIMUM_NUMBER_OF_BATCHES 10 /*!< Minimum number of batches of a run when uncertainty is computed batch by batch */
+
 class GGEMSNavigator;
 
 /*!
@@ -129,6 +131,13 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     void SetPhotonTracking(bool const& is_activated);
 
+    /*!
+      \fn inline bool IsPhotonTracking(void) const
+      \return true if photon tracking is activated
+      \brief checking if photon tracking is activated
+    */
+    inline bool IsPhotonTracking(void) const {return is_photon_tracking_;}
+
     /*!
       \fn void SetEdep(bool const& is_activated)
       \param is_activated - boolean activating energy deposit registration
@@ -179,6 +188,48 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     void SetTLE(bool const& is_activated);
 
+    /*!
+      \fn void SetLocalTally(bool const& is_activated)
+      \param is_activated - boolean activating local tally
+      \brief accumulating energy deposit in local memory of each work-group before recording it in global memory
+    */
+    void SetLocalTally(bool const& is_activated);
+
+    /*!
+      \fn inline bool IsLocalTally(void) const
+      \return true if energy deposit is accumulated in local memory
+      \brief checking if local tally is activated
+    */
+    inline bool IsLocalTally(void) const {return is_local_tally_;}
+
+    /*!
+      \fn void SetFixedPoint(bool const& is_activated)
+      \param is_activated - boolean activating fixed-point tallies
+      \brief accumulating energy deposit and energy squared deposit as 64 bits integers, tallies are bit-reproducible, limited to 4.29e9 MeV and 1.1e12 MeV2 by dosel
+    */
+    void SetFixedPoint(bool const& is_activated);
+
+    /*!
+      \fn inline bool IsFixedPoint(void) const
+      \return true if energy deposits are accumulated in fixed-point unit
+      \brief checking if fixed-point tallies are activated
+    */
+    inline bool IsFixedPoint(void) const {return is_fixed_point_;}
+
+    /*!
+      \fn void SetBatchUncertainty(bool const& is_activated)
+      \param is_activated - boolean activating batch uncertainty
+      \brief estimating uncertainty from energy deposit of each batch instead of each hit, no squared energy atomic during tracking. A run is split in at least MINIMUM_NUMBER_OF_BATCHES batches with the same maximum size on all devices. The formula assumes batches of equal size, batches of a device may still be smaller than the others with device balancing, biasing slightly the uncertainty
+    */
+    void SetBatchUncertainty(bool const& is_activated);
+
+    /*!
+      \fn inline bool IsBatchUncertainty(void) const
+      \return true if squared energy deposit is accumulated batch by batch
+      \brief checking if batch uncertainty is activated and useful
+    */
+    inline bool IsBatchUncertainty(void) const {return is_batch_uncertainty_ && (is_edep_squared_||is_uncertainty_);}
+
     /*!
       \fn inline cl::Buffer* GetPhotonTrackingBuffer(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -211,6 +262,14 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     inline cl::Buffer* GetEdepSquaredBuffer(GGsize const& thread_index) const {return dose_recording_.edep_squared_[thread_index];}
 
+    /*!
+      \fn inline cl::Buffer* GetEdepBatchBuffer(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \return OpenCL buffer for edep of current batch in batch uncertainty mode
+      \brief get the buffer for edep of current batch in batch uncertainty mode
+    */
+    inline cl::Buffer* GetEdepBatchBuffer(GGsize const& thread_index) const {return dose_recording_.edep_batch_[thread_index];}
+
     /*!
       \fn inline cl::Buffer* GetDoseParams(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -219,10 +278,29 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     inline cl::Buffer* GetDoseParams(GGsize const& thread_index) const {return dose_params_[thread_index];}
 
+    /*!
+      \fn void ReduceTallies(void)
+      \brief sum edep, edep squared, hit and photon tracking of all activated devices on first device
+    */
+    void ReduceTallies(void);
+
+    /*!
+      \fn void ResetTallies(void)
+      \brief clean edep, edep squared, hit and photon tracking on all activated devices before a new run
+    */
+    void ResetTallies(void);
+
+    /*!
+      \fn void AccumulateBatch(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief adding energy deposit of the batch and its square to running sums, batch uncertainty only
+    */
+    void AccumulateBatch(GGsize const& thread_index);
+
     /*!
       \fn void ComputeDose(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
-      \brief computing dose
+      \brief computing dose, dose and uncertainty buffers exist only on first device
     */
     void ComputeDose(GGsize const& thread_index);
 
@@ -281,6 +359,23 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     void SaveUncertainty(void) const;
 
+    /*!
+      \fn inline GGsize GetTallyTypeSize(void) const
+      \return size in bytes of one dosel in energy deposit tallies
+      \brief get size of tally type, 64 bits integer in fixed-point mode
+    */
+    inline GGsize GetTallyTypeSize(void) const {return is_fixed_point_ ? sizeof(GGulong) : sizeof(GGDosiType);}
+
+    /*!
+      \fn void ReadTally(cl::Buffer* tally, GGDosiType* tally_host, GGsize const& number_of_dosels, GGfloat const& fixed_point_scale) const
+      \param tally - energy deposit tally on first device
+      \param tally_host - energy deposit on host
+      \param number_of_dosels - number of dosels
+      \param fixed_point_scale - number of fixed-point units in 1 MeV (or 1 MeV2)
+      \brief copy an energy deposit tally to host, converting fixed-point unit to energy
+    */
+    void ReadTally(cl::Buffer* tally, GGDosiType* tally_host, GGsize const& number_of_dosels, GGfloat const& fixed_point_scale) const;
+
   private:
     GGfloat3 dosel_sizes_; /*!< Sizes of dosel */
     GGsize total_number_of_dosels_; /*!< Total number of dosels in image */
@@ -295,11 +390,16 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     bool is_hit_tracking_; /*!< Boolean for hit tracking */
     bool is_edep_squared_; /*!< Boolean for energy squared deposit */
     bool is_uncertainty_; /*!< Boolean for uncertainty computation */
+    bool is_local_tally_; /*!< Boolean for energy deposit accumulated in local memory */
+    bool is_fixed_point_; /*!< Boolean for energy deposit accumulated in fixed-point unit */
+    bool is_batch_uncertainty_; /*!< Boolean for uncertainty computed batch by batch */
+    GGint* number_of_batches_; /*!< Number of batches accumulated on each device */
     GGfloat scale_factor_; /*!< Scale factor */
     GGchar is_water_reference_; /*!< Water reference for dose computation */
     GGfloat minimum_density_; /*!< Minimum density value for dose computation */
 
     cl::Kernel** kernel_compute_dose_; /*!< OpenCL kernel computing dose in voxelized solid */
+    cl::Kernel** kernel_accumulate_batch_; /*!< OpenCL kernel adding energy deposit of a batch to running sums */
     GGsize number_activated_devices_; /*!< Number of activated device */
 };
 
@@ -409,6 +509,30 @@ extern "C" GGEMS_EXPORT void dose_uncertainty_dosimetry_calculator(GGEMSDosimetr
 */
 extern "C" GGEMS_EXPORT void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
 
+/*!
+  \fn void dose_local_tally_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean activating local tally
+  \brief accumulating energy deposit in local memory of work-groups
+*/
+extern "C" GGEMS_EXPORT void dose_local_tally_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
+/*!
+  \fn void dose_fixed_point_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean activating fixed-point tallies
+  \brief accumulating energy deposit as 64 bits integers
+*/
+extern "C" GGEMS_EXPORT void dose_fixed_point_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
+/*!
+  \fn void dose_batch_uncertainty_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean activating batch uncertainty
+  \brief estimating uncertainty batch by batch
+*/
+extern "C" GGEMS_EXPORT void dose_batch_uncertainty_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
 /*!
   \fn void attach_to_navigator_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, char const* navigator)
   \param dose_calculator - pointer on dose calculator
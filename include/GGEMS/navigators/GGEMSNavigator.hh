@@ -169,21 +169,21 @@ class GGEMS_EXPORT GGEMSNavigator
       \param thread_index - index of activated device (thread index)
       \brief Compute distance between particle and solid
     */
-    void ParticleSolidDistance(GGsize const& thread_index);
+    virtual void ParticleSolidDistance(GGsize const& thread_index);
 
     /*!
       \fn void ProjectToSolid(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
       \brief Project particle to entry of closest solid
     */
-    void ProjectToSolid(GGsize const& thread_index);
+    virtual void ProjectToSolid(GGsize const& thread_index);
 
     /*!
       \fn void TrackThroughSolid(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
       \brief Move particle through solid
     */
-    void TrackThroughSolid(GGsize const& thread_index);
+    virtual void TrackThroughSolid(GGsize const& thread_index);
 
     /*!
       \fn void PrintInfos(void) const
@@ -204,11 +204,56 @@ class GGEMS_EXPORT GGEMSNavigator
     virtual void SaveResults(void) = 0;
 
     /*!
-      \fn void ComputeDose(GGsize const& thread_index)
+      \fn void AccumulateBatch(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
-      \brief Compute dose in volume
+      \brief Add tallies of the ended batch to running sums if batch uncertainty is activated
     */
-    void ComputeDose(GGsize const& thread_index);
+    void AccumulateBatch(GGsize const& thread_index);
+
+    /*!
+      \fn GGsize GetMinimumNumberOfBatchs(void) const
+      \return minimum number of batchs of a run needed by navigator
+      \brief get the minimum number of batchs, more than 1 if uncertainty is computed batch by batch
+    */
+    GGsize GetMinimumNumberOfBatchs(void) const;
+
+    /*!
+      \fn void ComputeDose(void)
+      \brief Sum tallies of all activated devices and compute dose in volume once
+    */
+    void ComputeDose(void);
+
+    /*!
+      \fn void ResetTallies(void)
+      \brief clean dosimetry tallies and detector counts before a new run
+    */
+    void ResetTallies(void);
+
+    /*!
+      \fn void RotateGantry(GGfloat const& angle)
+      \param angle - rotation angle around Z axis (isocenter) in radian
+      \brief rotate the navigator with the gantry, only detector systems move, phantoms stay in place
+    */
+    virtual void RotateGantry(GGfloat const& angle) {}
+
+    /*!
+      \fn void ResetProjection(void)
+      \brief clean detector counts before simulating a new projection
+    */
+    virtual void ResetProjection(void) {}
+
+    /*!
+      \fn void SaveProjection(GGsize const& projection_index)
+      \param projection_index - index of the projection
+      \brief save detector counts of a projection
+    */
+    virtual void SaveProjection(GGsize const& projection_index) {}
+
+    /*!
+      \fn void SaveSweepResults(void)
+      \brief save results at the end of a gantry sweep, same as SaveResults if navigator does not save projections
+    */
+    virtual void SaveSweepResults(void) {SaveResults();}
 
     /*!
       \fn void StoreOutput(std::string basename)
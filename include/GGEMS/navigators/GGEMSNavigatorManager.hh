@@ -193,6 +193,12 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     */
     void SaveResults(void) const;
 
+    /*!
+      \fn void SaveSweepResults(void) const
+      \brief save results of a gantry sweep in files, detector counts are already saved projection by projection
+    */
+    void SaveSweepResults(void) const;
+
     /*!
       \fn void WorldTracking(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -201,11 +207,50 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     void WorldTracking(GGsize const& thread_index) const;
 
     /*!
-      \fn void ComputeDose(GGsize const& thread_index)
+      \fn void AccumulateBatch(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
-      \brief Compute dose in volume
+      \brief Add tallies of the ended batch to running sums in all navigators
+    */
+    void AccumulateBatch(GGsize const& thread_index) const;
+
+    /*!
+      \fn GGsize GetMinimumNumberOfBatchs(void) const
+      \return minimum number of batchs of a run needed by all navigators
+      \brief get the minimum number of batchs, more than 1 if uncertainty is computed batch by batch
+    */
+    GGsize GetMinimumNumberOfBatchs(void) const;
+
+    /*!
+      \fn void ComputeDose(void)
+      \brief Compute dose in volume and sum world tallies from tallies of all activated devices
+    */
+    void ComputeDose(void);
+
+    /*!
+      \fn void ResetTallies(void) const
+      \brief clean tallies of all the navigators and world before a new run
+    */
+    void ResetTallies(void) const;
+
+    /*!
+      \fn void RotateGantry(GGfloat const& angle) const
+      \param angle - rotation angle around Z axis (isocenter) in radian
+      \brief rotate all the detector systems with the gantry
+    */
+    void RotateGantry(GGfloat const& angle) const;
+
+    /*!
+      \fn void ResetProjection(void) const
+      \brief clean detector counts of all the navigators before a new projection
+    */
+    void ResetProjection(void) const;
+
+    /*!
+      \fn void SaveProjection(GGsize const& projection_index) const
+      \param projection_index - index of the projection
+      \brief save detector counts of a projection for all the navigators
     */
-    void ComputeDose(GGsize const& thread_index);
+    void SaveProjection(GGsize const& projection_index) const;
 
     /*!
       \fn void Clean(void)
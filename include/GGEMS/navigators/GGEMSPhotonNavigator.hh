@@ -46,7 +46,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn inline void GetPhotonNextInteraction(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGshort const index_material, GGint const index_particle)
+  \fn inline void GetPhotonNextInteraction(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGushort const index_material, GGint const index_particle)
   \param primary_particle - buffer of particles
   \param random - pointer on random numbers
   \param particle_cross_sections - buffer of cross sections
@@ -58,11 +58,11 @@ inline void GetPhotonNextInteraction(
   global GGEMSPrimaryParticles* primary_particle,
   global GGEMSRandom* random,
   global GGEMSParticleCrossSections const* particle_cross_sections,
-  GGuchar const index_material,
+  GGushort const index_material,
   GGint const particle_id)
 {
   // Getting energy of the particle and the index of energy in cross section table
-  GGint energy_id = BinarySearchLeft(primary_particle->E_[particle_id], particle_cross_sections->energy_bins_, particle_cross_sections->number_of_bins_, 0, 0);
+  GGint energy_id = LogScaleIndex(primary_particle->E_[particle_id], particle_cross_sections->log_energy_min_, particle_cross_sections->inverse_log_energy_step_, particle_cross_sections->number_of_bins_);
 
   // Initialization of next interaction distance
   GGfloat next_interaction_distance = OUT_OF_WORLD;
@@ -78,7 +78,7 @@ inline void GetPhotonNextInteraction(
     // Getting the interaction distance
     interaction_distance =
       -log(KissUniform(random, particle_id))/
-      particle_cross_sections->photon_cross_sections_[photon_process_id][energy_id + particle_cross_sections->number_of_bins_*index_material];
+      GetPhotonCrossSection(particle_cross_sections, photon_process_id, energy_id, index_material);
 
     if (interaction_distance < next_interaction_distance) {
       next_interaction_distance = interaction_distance;
@@ -97,7 +97,71 @@ inline void GetPhotonNextInteraction(
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn inline void PhotonDiscreteProcess(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGshort const material_id, GGint const particle_id)
+  \fn inline GGfloat GetPhotonMajorantInteractionDistance(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGint const particle_id)
+  \param primary_particle - buffer of particles
+  \param random - pointer on random numbers
+  \param particle_cross_sections - buffer of cross sections
+  \param particle_id - index of the particle
+  \return distance to next tentative interaction
+  \brief Sample the distance to next tentative interaction using the majorant cross section (Woodcock tracking)
+*/
+inline GGfloat GetPhotonMajorantInteractionDistance(
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  GGint const particle_id)
+{
+  // Getting energy of the particle and the index of energy in cross section table
+  GGint energy_id = LogScaleIndex(primary_particle->E_[particle_id], particle_cross_sections->log_energy_min_, particle_cross_sections->inverse_log_energy_step_, particle_cross_sections->number_of_bins_);
+  primary_particle->E_index_[particle_id] = energy_id;
+
+  return -log(KissUniform(random, particle_id))/particle_cross_sections->photon_majorant_cross_sections_[energy_id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGchar GetPhotonWoodcockProcess(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGushort const index_material, GGint const particle_id)
+  \param primary_particle - buffer of particles
+  \param random - pointer on random numbers
+  \param particle_cross_sections - buffer of cross sections
+  \param index_material - index of the material at the tentative interaction point
+  \param particle_id - index of the particle
+  \return selected photon process, NO_PROCESS for a fictitious interaction
+  \brief Accept or reject a tentative interaction and select the real process, one random number is used for both
+*/
+inline GGchar GetPhotonWoodcockProcess(
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  GGushort const index_material,
+  GGint const particle_id)
+{
+  GGint energy_id = primary_particle->E_index_[particle_id];
+
+  // Sampling uniformly in [0, majorant], each process occupies a slice equal to its cross section
+  GGfloat rnd_cross_section = KissUniform(random, particle_id) * particle_cross_sections->photon_majorant_cross_sections_[energy_id];
+  GGfloat cumulated_cross_section = 0.0f;
+  GGchar photon_process_id = 0;
+
+  for (GGchar i = 0; i < particle_cross_sections->number_of_activated_photon_processes_; ++i) {
+    photon_process_id = particle_cross_sections->photon_cs_id_[i];
+    cumulated_cross_section += GetPhotonCrossSection(particle_cross_sections, photon_process_id, energy_id, index_material);
+    if (rnd_cross_section < cumulated_cross_section) return photon_process_id;
+  }
+
+  // Remaining slice of majorant is a fictitious interaction
+  return NO_PROCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void PhotonDiscreteProcess(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGushort const material_id, GGint const particle_id)
   \param primary_particle - buffer of particles
   \param random - pointer on random numbers
   \param materials - buffer of materials
@@ -111,7 +175,7 @@ inline void PhotonDiscreteProcess(
   global GGEMSRandom* random,
   global GGEMSMaterialTables const* materials,
   global GGEMSParticleCrossSections const* particle_cross_sections,
-  GGuchar const material_id,
+  GGushort const material_id,
   GGint const particle_id
 )
 {
@@ -133,12 +133,66 @@ class GGEMS_EXPORT GGEMSSystem : public GGEMSNavigator
     */
     void SetGlobalSystemPosition(GGfloat const& global_system_position_x, GGfloat const& global_system_position_y, GGfloat const& global_system_position_z, std::string const& unit = "mm");
 
+    /*!
+      \fn void EnableSolidTable(bool const& is_solid_table)
+      \param is_solid_table - true to navigate all the modules with a single table of solids
+      \brief set to true to launch one kernel per stage for all the modules instead of one kernel per module
+    */
+    void EnableSolidTable(bool const& is_solid_table);
+
     /*!
       \fn void SaveResults(void) override
       \brief save all results from solid
     */
     void SaveResults(void) override;
 
+    /*!
+      \fn void RotateGantry(GGfloat const& angle) override
+      \param angle - rotation angle around Z axis (isocenter) in radian
+      \brief rotate all the modules around isocenter, transformation matrices are updated on each device
+    */
+    void RotateGantry(GGfloat const& angle) override;
+
+    /*!
+      \fn void ResetProjection(void) override
+      \brief clean histograms of all modules on each device
+    */
+    void ResetProjection(void) override;
+
+    /*!
+      \fn void SaveProjection(GGsize const& projection_index) override
+      \param projection_index - index of the projection
+      \brief save histograms of a projection, index is appended to output basename
+    */
+    void SaveProjection(GGsize const& projection_index) override;
+
+    /*!
+      \fn void SaveSweepResults(void) override
+      \brief nothing to save at the end of a gantry sweep, histograms are saved projection by projection
+    */
+    void SaveSweepResults(void) override;
+
+    /*!
+      \fn void ParticleSolidDistance(GGsize const& thread_index) override
+      \param thread_index - index of activated device (thread index)
+      \brief Compute distance between particle and modules
+    */
+    void ParticleSolidDistance(GGsize const& thread_index) override;
+
+    /*!
+      \fn void ProjectToSolid(GGsize const& thread_index) override
+      \param thread_index - index of activated device (thread index)
+      \brief Project particle to entry of closest module
+    */
+    void ProjectToSolid(GGsize const& thread_index) override;
+
+    /*!
+      \fn void TrackThroughSolid(GGsize const& thread_index) override
+      \param thread_index - index of activated device (thread index)
+      \brief Move particle through module
+    */
+    void TrackThroughSolid(GGsize const& thread_index) override;
+
   protected:
     /*!
       \fn void CheckParameters(void) const override
@@ -146,12 +200,59 @@ class GGEMS_EXPORT GGEMSSystem : public GGEMSNavigator
     */
     virtual void CheckParameters(void) const override;
 
+    /*!
+      \fn void InitializeSolidTable(void)
+      \brief allocate the table of solids and the histograms of all the modules, and compile table kernels
+    */
+    void InitializeSolidTable(void);
+
+    /*!
+      \fn void UpdateSolidTable(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief copy data of each module (solid id, transformation matrix) in the table of solids
+    */
+    void UpdateSolidTable(GGsize const& thread_index);
+
+    /*!
+      \fn void LaunchSolidTableKernel(cl::Kernel* kernel, GGsize const& thread_index, std::string const& method_name) const
+      \param kernel - table kernel, arguments after particles already set
+      \param thread_index - index of activated device (thread index)
+      \param method_name - name of the calling method, for errors and profiling
+      \brief set the particle arguments of a table kernel and launch it on all particles of the device
+    */
+    void LaunchSolidTableKernel(cl::Kernel* kernel, GGsize const& thread_index, std::string const& method_name) const;
+
+  private:
+    /*!
+      \fn void AccumulateHistogram(GGint* output, bool const& is_scatter) const
+      \param output - buffer storing all the modules on host
+      \param is_scatter - true to read the scatter histogram
+      \brief sum the histograms of all modules from all devices in output buffer
+    */
+    void AccumulateHistogram(GGint* output, bool const& is_scatter) const;
+
+    /*!
+      \fn void SaveHistograms(std::string const& output_basename) const
+      \param output_basename - basename of output file
+      \brief save histogram and scatter histogram of all modules in MHD format
+    */
+    void SaveHistograms(std::string const& output_basename) const;
+
   protected:
     GGsize2 number_of_modules_xy_; /*!< Number of the detection modules */
     GGsize3 number_of_detection_elements_inside_module_xyz_; /*!< Number of virtual elements (X,Y,Z) in a module */
     GGfloat3 size_of_detection_elements_xyz_; /*!< Size of pixel in each direction */
     bool is_scatter_; /*!< Boolean storing scatter infos */
     GGfloat3 global_system_position_xyz_; /*!< Global position of the system in X, Y and Z */
+
+    // Solid table mode
+    bool is_solid_table_; /*!< Boolean activating navigation with table of solids */
+    cl::Buffer** solid_table_; /*!< Table of solid box data for each module */
+    cl::Buffer** histogram_table_; /*!< Histograms of all the modules, one after the other */
+    cl::Buffer** scatter_table_; /*!< Scatter histograms of all the modules, one after the other */
+    cl::Kernel** kernel_particle_solid_distance_table_; /*!< OpenCL kernel computing distance between particles and all modules */
+    cl::Kernel** kernel_project_to_solid_table_; /*!< OpenCL kernel moving particles to closest module */
+    cl::Kernel** kernel_track_through_solid_table_; /*!< OpenCL kernel tracking particles within modules */
 };
 
 #endif // End of GUARD_GGEMS_SYSTEMS_GGEMSSYSTEM_HH
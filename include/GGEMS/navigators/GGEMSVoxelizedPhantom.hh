@@ -86,6 +86,13 @@ class GGEMS_EXPORT GGEMSVoxelizedPhantom : public GGEMSNavigator
     */
     void SetPhantomFile(std::string const& voxelized_phantom_filename, std::string const& range_data_filename);
 
+    /*!
+      \fn void SetWoodcockTracking(bool const& is_woodcock)
+      \param is_woodcock - flag activating Woodcock (delta) tracking
+      \brief track photons in phantom with a majorant cross section instead of stepping voxel by voxel
+    */
+    void SetWoodcockTracking(bool const& is_woodcock);
+
     /*!
       \fn void Initialize(void) override
       \brief Initialize the voxelized phantom
@@ -108,6 +115,7 @@ class GGEMS_EXPORT GGEMSVoxelizedPhantom : public GGEMSNavigator
   private:
     std::string voxelized_phantom_filename_; /*!< MHD file storing the voxelized phantom */
     std::string range_data_filename_; /*!< File for label to material matching */
+    bool is_woodcock_; /*!< Flag for Woodcock tracking in phantom */
 };
 
 /*!
@@ -186,4 +194,12 @@ extern "C" GGEMS_EXPORT void set_material_color_ggems_voxelized_phantom(GGEMSVox
 */
 extern "C" GGEMS_EXPORT void set_material_color_name_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* material_name, char const* color_name);
 
+/*!
+  \fn void set_woodcock_tracking_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, bool const flag)
+  \param voxelized_phantom - pointer on voxelized phantom
+  \param flag - flag activating Woodcock tracking
+  \brief Set Woodcock tracking in voxelized phantom
+*/
+extern "C" GGEMS_EXPORT void set_woodcock_tracking_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, bool const flag);
+
 #endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSVOXELIZEDPHANTOM_HH
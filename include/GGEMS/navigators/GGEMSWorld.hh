@@ -160,12 +160,24 @@ class GGEMS_EXPORT GGEMSWorld
     */
     void Tracking(GGsize const& thread_index);
 
+    /*!
+      \fn void ReduceTallies(void)
+      \brief sum world tallies of all activated devices on first device, called before saving results
+    */
+    void ReduceTallies(void);
+
     /*!
       \fn void SaveResults(void) const
       \brief save all results from world
     */
     void SaveResults(void) const;
 
+    /*!
+      \fn void ResetTallies(void) const
+      \brief clean all world tallies on each activated device before a new run
+    */
+    void ResetTallies(void) const;
+
     /*!
       \fn void EnableTracking(void)
       \brief Enable tracking during simulation
@@ -132,6 +132,22 @@ class GGEMS_EXPORT GGEMSAttenuations
     */
     void LoadAttenuationsOnHost(void);
 
+    /*!
+      \fn bool LoadAttenuationsFromCache(std::string const& filename, GGEMSMuMuEnData* attenuations) const
+      \param filename - name of cache file
+      \param attenuations - attenuation tables on host
+      \return true if tables are read from a valid cache file
+      \brief read attenuation tables computed in a previous run
+    */
+    bool LoadAttenuationsFromCache(std::string const& filename, GGEMSMuMuEnData* attenuations) const;
+
+    /*!
+      \fn void SaveAttenuationsToCache(std::string const& filename) const
+      \param filename - name of cache file
+      \brief save the used part of attenuation tables
+    */
+    void SaveAttenuationsToCache(std::string const& filename) const;
+
   private:
     GGsize number_activated_devices_; /*!< Number of activated device */
 
@@ -145,6 +161,7 @@ class GGEMS_EXPORT GGEMSAttenuations
 
     // OpenCL Buffer
     cl::Buffer** mu_tables_; /*!< attenuations coefficients on OpenCL device */
+    std::string table_key_; /*!< Description of content of tables, key in shared tables of process manager */
 };
 
 /*!
@@ -120,6 +120,13 @@ class GGEMS_EXPORT GGEMSCrossSections
     */
     inline GGsize GetNumberOfActivatedEMProcesses(void) const {return number_of_activated_processes_;}
 
+    /*!
+      \fn inline std::string GetTableKey(void) const
+      \return description of the content of cross section tables
+      \brief get the description of materials, processes and energy range of tables, tables with the same description are shared between navigators
+    */
+    inline std::string GetTableKey(void) const {return table_key_;}
+
     /*!
       \fn inline cl::Buffer* GetCrossSections(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -152,14 +159,52 @@ class GGEMS_EXPORT GGEMSCrossSections
     */
     void LoadPhysicTablesOnHost(void);
 
+    /*!
+      \fn void ComputeMajorantCrossSections(void)
+      \brief Compute the maximum of the total photon cross section over all materials for each energy bin, used by Woodcock tracking
+    */
+    void ComputeMajorantCrossSections(void);
+
+    /*!
+      \fn std::string BuildTableKey(void) const
+      \return description of the content of cross section tables
+      \brief describe the ordered materials, ordered processes and energy range of tables
+    */
+    std::string BuildTableKey(void) const;
+
+    /*!
+      \fn std::string GetCacheFilename(void) const
+      \return name of cache file storing tables, empty if cache disabled
+      \brief get the name of cache file from the hash of table description
+    */
+    std::string GetCacheFilename(void) const;
+
+    /*!
+      \fn bool LoadTablesFromCache(std::string const& filename, GGEMSParticleCrossSections* particle_cross_sections) const
+      \param filename - name of cache file
+      \param particle_cross_sections - cross section tables on host
+      \return true if tables are read from a valid cache file
+      \brief read cross section tables computed in a previous run
+    */
+    bool LoadTablesFromCache(std::string const& filename, GGEMSParticleCrossSections* particle_cross_sections) const;
+
+    /*!
+      \fn void SaveTablesToCache(std::string const& filename) const
+      \param filename - name of cache file
+      \brief save the used part of cross section tables
+    */
+    void SaveTablesToCache(std::string const& filename) const;
+
   private:
     GGEMSEMProcess** em_processes_list_; /*!< vector of electromagnetic processes */
     GGsize number_of_activated_processes_; /*!< Number of activated processes */
     std::vector<bool> is_process_activated_; /*!< Boolean checking if the process is already activated */
     cl::Buffer** particle_cross_sections_; /*!< Pointer storing cross sections for each particles on OpenCL device */
-    GGEMSParticleCrossSections* particle_cross_sections_host_; /*!< Pointer storing cross sections for each particles on host (RAM memory) */
+    GGEMSParticleCrossSections* particle_cross_sections_host_; /*!< Pointer storing cross sections for each particles on host (RAM memory), header followed by tables */
+    GGsize particle_cross_sections_size_; /*!< Size in bytes of cross sections, header and tables sized with materials and bins */
     GGsize number_activated_devices_; /*!< Number of activated device */
     GGEMSMaterials* materials_; /*!< Pointer to material defined in a navigator */
+    std::string table_key_; /*!< Description of content of tables, key in shared tables of process manager */
 };
 
 /*!
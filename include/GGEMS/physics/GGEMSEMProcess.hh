@@ -39,6 +39,8 @@
 #include "GGEMS/global/GGEMSOpenCLManager.hh"
 #include "GGEMS/physics/GGEMSParticleCrossSections.hh"
 
+class GGEMSMaterials;
+
 /*!
   \class GGEMSEMProcess
   \brief GGEMS mother class for electromagnectic process
@@ -92,13 +94,20 @@ class GGEMS_EXPORT GGEMSEMProcess
     inline std::string GetProcessName(void) const {return process_name_;}
 
     /*!
-      \fn void BuildCrossSectionTables(cl::Buffer* particle_cross_sections, cl::Buffer* material_tables, GGsize const& thread_index)
-      \param particle_cross_sections - OpenCL buffer storing all the cross section tables for each particles
-      \param material_tables - material tables on OpenCL device
-      \param thread_index - index of activated device (thread index)
-      \brief build cross section tables and storing them in particle_cross_sections
+      \fn inline GGchar GetProcessID(void) const
+      \return id of the process as defined in GGEMSEMProcessConstants.hh
+      \brief get the id of the process
+    */
+    inline GGchar GetProcessID(void) const {return process_id_;}
+
+    /*!
+      \fn void BuildCrossSectionTables(GGEMSParticleCrossSections* particle_cross_sections, GGEMSMaterialTables const* material_tables, GGEMSMaterials const* materials)
+      \param particle_cross_sections - cross section tables on host, computed once for all devices, offsets of tables already set
+      \param material_tables - material tables
+      \param materials - materials, names are used when tables are printed
+      \brief build cross section tables and storing them in particle_cross_sections, energy bins are computed by host threads
     */
-    virtual void BuildCrossSectionTables(cl::Buffer* particle_cross_sections, cl::Buffer* material_tables, GGsize const& thread_index);
+    virtual void BuildCrossSectionTables(GGEMSParticleCrossSections* particle_cross_sections, GGEMSMaterialTables const* material_tables, GGEMSMaterials const* materials);
 
   protected:
     /*!
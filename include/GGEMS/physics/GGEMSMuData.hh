@@ -32,6 +32,7 @@
   \date Monday June 10, 2020
 */
 
+#include "GGEMS/global/GGEMSConfiguration.hh"
 #include "GGEMS/tools/GGEMSSystemOfUnits.hh"
 #include "GGEMS/physics/GGEMSProcessConstants.hh"
 
@@ -42,14 +43,16 @@
 typedef struct GGEMSMuMuEnData_t
 {
   GGfloat energy_bins_[ATTENUATION_TABLE_NUMBER_BINS]; /*!< Number of energy bins */
-  GGfloat mu_[256*ATTENUATION_TABLE_NUMBER_BINS]; /*!< attenuation coefficient values for each material (n*k) */
-  GGfloat mu_en_[256*ATTENUATION_TABLE_NUMBER_BINS]; /*!< energy-absorption coefficient for each material (n*k) */
+  GGfloat mu_[MAXIMUM_MATERIALS*ATTENUATION_TABLE_NUMBER_BINS]; /*!< attenuation coefficient values for each material (n*k) */
+  GGfloat mu_en_[MAXIMUM_MATERIALS*ATTENUATION_TABLE_NUMBER_BINS]; /*!< energy-absorption coefficient for each material (n*k) */
 
   GGint number_of_materials_; /*!< Number of materials : k */
   GGint number_of_bins_; /*!< Number of bins : n */
 
   GGfloat energy_min_; /*!< Minimum of energy */
   GGfloat energy_max_; /*!< Maximum of energy */
+  GGfloat log_energy_min_; /*!< Log of first energy bin, for direct index computation */
+  GGfloat inverse_log_energy_step_; /*!< Inverse of log energy step between 2 bins, for direct index computation */
 } GGEMSMuMuEnData; /*!< Using C convention name of struct to C++ (_t deletion) */
 
 #endif
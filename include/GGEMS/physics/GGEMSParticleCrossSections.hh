@@ -35,7 +35,7 @@
 
 /*!
   \struct GGEMSParticleCrossSections_t
-  \brief Structure storing the photon cross sections for OpenCL device
+  \brief Structure storing the photon cross sections for OpenCL device, this header is followed in the same buffer by the tables sized with the real number of materials and bins
 */
 typedef struct GGEMSParticleCrossSections_t
 {
@@ -45,16 +45,102 @@ typedef struct GGEMSParticleCrossSections_t
   GGfloat min_energy_; /*!< Min energy in the cross section table */
   GGfloat max_energy_; /*!< Max energy in the cross section table */
   GGfloat energy_bins_[MAX_CROSS_SECTION_TABLE_NUMBER_BINS]; /*!< Energy in bin (220 by default) */
+  GGfloat log_energy_min_; /*!< Log of first energy bin, for direct index computation */
+  GGfloat inverse_log_energy_step_; /*!< Inverse of log energy step between 2 bins, for direct index computation */
 
   // Photon
-  // 256: Max number of materials [0...255]
-  // MAX_CROSS_SECTION_TABLE_NUMBER_BINS: Max number of bins [0...2047]
-  GGfloat photon_cross_sections_[NUMBER_PHOTON_PROCESSES][256*MAX_CROSS_SECTION_TABLE_NUMBER_BINS]; /*!< Photon cross sections per material in mm-1 */
-  GGfloat photon_cross_sections_per_atom_[NUMBER_PHOTON_PROCESSES][101*MAX_CROSS_SECTION_TABLE_NUMBER_BINS]; /*!< Photon cross sections per atom in mm-1, 100 chemical elements + 1 first empty element */
   GGsize number_of_activated_photon_processes_; /*!< Number of activated photon processes, 3 processes -> 0: Compton, 1: Photoelectric, 2: Rayleigh */
   GGchar photon_cs_id_[NUMBER_PHOTON_PROCESSES]; /*!< Index of activated photon process, ex: if only Rayleigh activate index_photon_cs[0] = 2 */
+  GGfloat photon_majorant_cross_sections_[MAX_CROSS_SECTION_TABLE_NUMBER_BINS]; /*!< Maximum of total photon cross section over all materials in mm-1, used by Woodcock tracking */
 
-  GGchar material_names_[256][64]; /*!< Name of the materials */
+  // Offsets (in number of floats) of tables stored after this header, only activated processes have tables
+  GGsize photon_cross_sections_offset_[NUMBER_PHOTON_PROCESSES]; /*!< Offset of photon cross sections per material in mm-1, [material][bin] */
+  GGsize photon_cross_sections_per_atom_offset_[NUMBER_PHOTON_PROCESSES]; /*!< Offset of photon cross sections per atom in mm-1, [Z][bin] with 100 chemical elements + 1 first empty element */
+  GGsize number_of_table_values_; /*!< Number of floats stored after this header */
 } GGEMSParticleCrossSections; /*!< Using C convention name of struct to C++ (_t deletion) */
 
+#ifdef __OPENCL_C_VERSION__
+
+/*!
+  \fn inline GGfloat GetPhotonCrossSection(global GGEMSParticleCrossSections const* particle_cross_sections, GGchar const process_id, GGint const energy_id, GGushort const material_id)
+  \param particle_cross_sections - buffer of cross sections
+  \param process_id - index of photon process
+  \param energy_id - index of energy bin
+  \param material_id - index of material
+  \return photon cross section of a material in mm-1
+  \brief read a photon cross section per material in tables following the header
+*/
+inline GGfloat GetPhotonCrossSection(global GGEMSParticleCrossSections const* particle_cross_sections, GGchar const process_id, GGint const energy_id, GGushort const material_id)
+{
+  global GGfloat const* tables = (global GGfloat const*)(particle_cross_sections + 1);
+  return tables[particle_cross_sections->photon_cross_sections_offset_[process_id] + energy_id + particle_cross_sections->number_of_bins_*material_id];
+}
+
+/*!
+  \fn inline GGfloat GetPhotonCrossSectionPerAtom(global GGEMSParticleCrossSections const* particle_cross_sections, GGchar const process_id, GGint const energy_id, GGuchar const atomic_number)
+  \param particle_cross_sections - buffer of cross sections
+  \param process_id - index of photon process
+  \param energy_id - index of energy bin
+  \param atomic_number - Z of chemical element
+  \return photon cross section of an atom in mm-1
+  \brief read a photon cross section per atom in tables following the header
+*/
+inline GGfloat GetPhotonCrossSectionPerAtom(global GGEMSParticleCrossSections const* particle_cross_sections, GGchar const process_id, GGint const energy_id, GGuchar const atomic_number)
+{
+  global GGfloat const* tables = (global GGfloat const*)(particle_cross_sections + 1);
+  return tables[particle_cross_sections->photon_cross_sections_per_atom_offset_[process_id] + energy_id + particle_cross_sections->number_of_bins_*atomic_number];
+}
+
+#else
+
+/*!
+  \fn inline GGfloat* GetPhotonCrossSections(GGEMSParticleCrossSections* particle_cross_sections, GGchar const& process_id)
+  \param particle_cross_sections - cross sections, header followed by tables
+  \param process_id - index of photon process
+  \return pointer to photon cross sections per material of a process
+  \brief get the table of photon cross sections per material following the header
+*/
+inline GGfloat* GetPhotonCrossSections(GGEMSParticleCrossSections* particle_cross_sections, GGchar const& process_id)
+{
+  return reinterpret_cast<GGfloat*>(particle_cross_sections + 1) + particle_cross_sections->photon_cross_sections_offset_[process_id];
+}
+
+/*!
+  \fn inline GGfloat const* GetPhotonCrossSections(GGEMSParticleCrossSections const* particle_cross_sections, GGchar const& process_id)
+  \param particle_cross_sections - cross sections, header followed by tables
+  \param process_id - index of photon process
+  \return pointer to photon cross sections per material of a process
+  \brief get the table of photon cross sections per material following the header
+*/
+inline GGfloat const* GetPhotonCrossSections(GGEMSParticleCrossSections const* particle_cross_sections, GGchar const& process_id)
+{
+  return reinterpret_cast<GGfloat const*>(particle_cross_sections + 1) + particle_cross_sections->photon_cross_sections_offset_[process_id];
+}
+
+/*!
+  \fn inline GGfloat* GetPhotonCrossSectionsPerAtom(GGEMSParticleCrossSections* particle_cross_sections, GGchar const& process_id)
+  \param particle_cross_sections - cross sections, header followed by tables
+  \param process_id - index of photon process
+  \return pointer to photon cross sections per atom of a process
+  \brief get the table of photon cross sections per atom following the header
+*/
+inline GGfloat* GetPhotonCrossSectionsPerAtom(GGEMSParticleCrossSections* particle_cross_sections, GGchar const& process_id)
+{
+  return reinterpret_cast<GGfloat*>(particle_cross_sections + 1) + particle_cross_sections->photon_cross_sections_per_atom_offset_[process_id];
+}
+
+/*!
+  \fn inline GGfloat const* GetPhotonCrossSectionsPerAtom(GGEMSParticleCrossSections const* particle_cross_sections, GGchar const& process_id)
+  \param particle_cross_sections - cross sections, header followed by tables
+  \param process_id - index of photon process
+  \return pointer to photon cross sections per atom of a process
+  \brief get the table of photon cross sections per atom following the header
+*/
+inline GGfloat const* GetPhotonCrossSectionsPerAtom(GGEMSParticleCrossSections const* particle_cross_sections, GGchar const& process_id)
+{
+  return reinterpret_cast<GGfloat const*>(particle_cross_sections + 1) + particle_cross_sections->photon_cross_sections_per_atom_offset_[process_id];
+}
+
+#endif
+
 #endif // GUARD_GGEMS_PHYSICS_GGEMSPARTICLECROSSSECTIONS_HH
@@ -116,12 +116,26 @@ class GGEMS_EXPORT GGEMSParticles
     inline GGsize GetNumberOfParticles(GGsize const& thread_index) const {return number_of_particles_[thread_index];}
 
     /*!
-      \fn bool IsAlive(GGsize const& thread_index) const
+      \fn bool IsAlive(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
       \return true if source is still alive, otherwize false
       \brief check if some particles are alive in OpenCL particle buffer
     */
-    bool IsAlive(GGsize const& thread_index) const;
+    bool IsAlive(GGsize const& thread_index);
+
+    /*!
+      \fn void EnableCompaction(void)
+      \brief pack alive particles at the beginning of the buffer after each step, so kernels are launched only on alive particles
+    */
+    void EnableCompaction(void);
+
+    /*!
+      \fn GGsize GetBufferSize(GGsize const& particle_capacity) const
+      \param particle_capacity - number of particles in buffer
+      \return size in bytes of a particle buffer
+      \brief compute the size of a particle buffer for a capacity chosen at runtime
+    */
+    GGsize GetBufferSize(GGsize const& particle_capacity) const;
 
     /*!
       \fn void Dump(std::string const& message) const
@@ -143,12 +157,30 @@ class GGEMS_EXPORT GGEMSParticles
     */
     void InitializeKernel(void);
 
+    /*!
+      \fn GGsize CompactParticles(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \return number of alive particles
+      \brief copy alive particles at the beginning of a second particle buffer and swap the buffers
+    */
+    GGsize CompactParticles(GGsize const& thread_index);
+
   private:
     GGsize* number_of_particles_; /*!< Number of activated particles in buffer */
     cl::Buffer** primary_particles_; /*!< Pointer storing info about primary particles in batch on OpenCL device */
     cl::Buffer** status_; /*!< Buffer storing status of particle */
     GGsize number_activated_devices_; /*!< Number of activated device */
+    GGsize particle_buffer_size_; /*!< Size in bytes of particle buffer on each device */
     cl::Kernel** kernel_alive_; /*!< Kernel checking if particles are alive */
+
+    // Compaction of particles
+    bool is_compaction_; /*!< Boolean activating compaction of particles */
+    GGsize number_of_groups_; /*!< Maximum number of work-groups over particle buffer */
+    cl::Buffer** compacted_particles_; /*!< Particle buffer receiving alive particles, swapped with primary particles */
+    cl::Buffer** group_alive_; /*!< Number of alive particles, then offset, for each work-group */
+    cl::Kernel** kernel_count_alive_; /*!< Kernel counting alive particles per work-group */
+    cl::Kernel** kernel_scan_alive_; /*!< Kernel computing offset of each work-group */
+    cl::Kernel** kernel_compact_particles_; /*!< Kernel copying alive particles */
 };
 
 #endif // End of GUARD_GGEMS_PHYSICS_GGEMSPARTICLES_HH
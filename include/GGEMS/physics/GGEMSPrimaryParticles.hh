@@ -43,6 +43,12 @@ typedef struct GGEMSPrimaryParticles_t
 {
   GGint particle_tracking_id; /*!< Particle id for tracking */
 
+  GGfloat px_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in X of primary particles interactions */
+  GGfloat py_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in Y of primary particles interactions */
+  GGfloat pz_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in Z of primary particles interactions */
+  GGint stored_particles_gl_[MAXIMUM_DISPLAYED_PARTICLES]; /*!< index to current interaction particle to store */
+
+  // Arrays below are sized with the particle capacity chosen at runtime, host only accesses fields above
   GGfloat E_[MAXIMUM_PARTICLES]; /*!< Energies of particles */
   GGfloat dx_[MAXIMUM_PARTICLES]; /*!< Direction of the particle in x */
   GGfloat dy_[MAXIMUM_PARTICLES]; /*!< Direction of the particle in y */
@@ -62,11 +68,6 @@ typedef struct GGEMSPrimaryParticles_t
   GGchar status_[MAXIMUM_PARTICLES]; /*!< Status of the particle */
   GGchar level_[MAXIMUM_PARTICLES]; /*!< Level of the particle */
   GGchar pname_[MAXIMUM_PARTICLES]; /*!< particle name (photon, electron, etc) */
-
-  GGfloat px_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in X of primary particles interactions */
-  GGfloat py_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in Y of primary particles interactions */
-  GGfloat pz_gl_[MAXIMUM_DISPLAYED_PARTICLES*MAXIMUM_INTERACTIONS]; /*!< Position in Z of primary particles interactions */
-  GGint stored_particles_gl_[MAXIMUM_DISPLAYED_PARTICLES]; /*!< index to current interaction particle to store */
 } GGEMSPrimaryParticles; /*!< Using C convention name of struct to C++ (_t deletion) */
 
 #endif // GUARD_GGEMS_PHYSICS_GGEMSPRIMARYPARTICLESSTACK_HH
@@ -31,9 +31,17 @@
   \date Monday March 9, 2020
 */
 
+#include <string>
+#include <vector>
+#include <unordered_map>
+
 #include "GGEMS/global/GGEMSExport.hh"
 #include "GGEMS/physics/GGEMSProcessConstants.hh"
 
+namespace cl {
+  class Buffer;
+}
+
 /*!
   \class GGEMSProcessesManager
   \brief GGEMS class managing the processes in GGEMS simulation
@@ -176,11 +184,68 @@ class GGEMS_EXPORT GGEMSProcessesManager
     */
     void Clean(void);
 
+    /*!
+      \fn cl::Buffer* const* GetSharedTables(std::string const& table_key)
+      \param table_key - description of the content of physic tables
+      \return buffers of physic tables on each activated device, nullptr if tables with this content are not built yet
+      \brief get physic tables already built by another navigator, the caller becomes a user of these tables
+    */
+    cl::Buffer* const* GetSharedTables(std::string const& table_key);
+
+    /*!
+      \fn void RegisterSharedTables(std::string const& table_key, cl::Buffer* const* tables, GGsize const& number_of_activated_devices)
+      \param table_key - description of the content of physic tables
+      \param tables - buffers of physic tables on each activated device
+      \param number_of_activated_devices - number of activated devices
+      \brief register physic tables built by a navigator, so other navigators with same content use them
+    */
+    void RegisterSharedTables(std::string const& table_key, cl::Buffer* const* tables, GGsize const& number_of_activated_devices);
+
+    /*!
+      \fn bool ReleaseSharedTables(std::string const& table_key)
+      \param table_key - description of the content of physic tables
+      \return true if the caller was the last user of tables (or tables never registered), the caller has to deallocate them
+      \brief release physic tables used by a navigator
+    */
+    bool ReleaseSharedTables(std::string const& table_key);
+
+    /*!
+      \fn void SetPhysicTablesCacheDirectory(std::string const& directory)
+      \param directory - directory storing computed physic tables, empty string to disable cache
+      \brief set the directory of the on-disk cache of cross section and attenuation tables
+    */
+    void SetPhysicTablesCacheDirectory(std::string const& directory);
+
+    /*!
+      \fn inline std::string GetPhysicTablesCacheDirectory(void) const
+      \return directory storing computed physic tables, empty if cache disabled
+      \brief get the directory of the on-disk cache of physic tables
+    */
+    inline std::string GetPhysicTablesCacheDirectory(void) const {return physic_tables_cache_directory_;}
+
+    /*!
+      \fn void SetNumberOfHostThreads(GGsize const& number_of_threads)
+      \param number_of_threads - number of host threads computing physic tables
+      \brief set the number of host threads used to compute cross section, attenuation and cut tables
+    */
+    void SetNumberOfHostThreads(GGsize const& number_of_threads);
+
+    /*!
+      \fn inline GGsize GetNumberOfHostThreads(void) const
+      \return number of host threads computing physic tables
+      \brief get the number of host threads used to compute physic tables
+    */
+    inline GGsize GetNumberOfHostThreads(void) const {return number_of_host_threads_;}
+
   private:
     GGsize cross_section_table_number_of_bins_; /*!< Number of bins in the cross section table */
     GGfloat cross_section_table_min_energy_; /*!< Minimum energy in the cross section table */
     GGfloat cross_section_table_max_energy_; /*!< Maximum energy in the cross section table */
     bool is_processes_print_tables_; /*!< Flag for physic tables printing */
+    std::unordered_map<std::string, std::vector<cl::Buffer*>> shared_tables_; /*!< Physic tables on each device hashed by their content */
+    std::unordered_map<std::string, GGsize> shared_tables_users_; /*!< Number of navigators using each physic table */
+    std::string physic_tables_cache_directory_; /*!< Directory storing computed physic tables, empty if cache disabled */
+    GGsize number_of_host_threads_; /*!< Number of host threads computing physic tables */
 };
 
 /*!
@@ -248,4 +313,20 @@ extern "C" GGEMS_EXPORT void print_available_processes_manager(GGEMSProcessesMan
 */
 extern "C" GGEMS_EXPORT void print_tables_processes_manager(GGEMSProcessesManager* processes_manager, bool const is_processes_print_tables);
 
+/*!
+  \fn void set_physic_tables_cache_directory_processes_manager(GGEMSProcessesManager* processes_manager, char const* directory)
+  \param processes_manager - pointer on the processes manager
+  \param directory - directory storing computed physic tables
+  \brief set the directory of the on-disk cache of physic tables
+*/
+extern "C" GGEMS_EXPORT void set_physic_tables_cache_directory_processes_manager(GGEMSProcessesManager* processes_manager, char const* directory);
+
+/*!
+  \fn void set_number_of_host_threads_processes_manager(GGEMSProcessesManager* processes_manager, GGsize const number_of_threads)
+  \param processes_manager - pointer on the processes manager
+  \param number_of_threads - number of host threads computing physic tables
+  \brief set the number of host threads used to compute physic tables
+*/
+extern "C" GGEMS_EXPORT void set_number_of_host_threads_processes_manager(GGEMSProcessesManager* processes_manager, GGsize const number_of_threads);
+
 #endif // GUARD_GGEMS_PHYSICS_GGEMSRANGECUTSMANAGER_HH
@@ -157,7 +157,7 @@ constant GGfloat PP8[101] = { 0.0f,
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn inline void KleinNishinaComptonSampleSecondaries(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGshort const material_id, GGint const particle_id)
+  \fn inline void KleinNishinaComptonSampleSecondaries(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGushort const material_id, GGint const particle_id)
   \param primary_particle - buffer of particles
   \param random - pointer on random numbers
   \param materials - buffer of materials
@@ -171,7 +171,7 @@ inline void LivermoreRayleighSampleSecondaries(
   global GGEMSRandom* random,
   global GGEMSMaterialTables const* materials,
   global GGEMSParticleCrossSections const* particle_cross_sections,
-  GGuchar const material_id,
+  GGushort const material_id,
   GGint const particle_id
 )
 {
@@ -189,9 +189,8 @@ inline void LivermoreRayleighSampleSecondaries(
     primary_particle->dz_[particle_id]
   };
 
-  GGshort kNumberOfBins = particle_cross_sections->number_of_bins_;
   GGchar kNEltsMinusOne = materials->number_of_chemical_elements_[material_id]-1;
-  GGshort kMixtureID = materials->index_of_chemical_elements_[material_id];
+  GGint kMixtureID = materials->index_of_chemical_elements_[material_id];
   GGint kEnergyID = primary_particle->E_index_[particle_id];
 
   // Get last atom
@@ -203,9 +202,9 @@ inline void LivermoreRayleighSampleSecondaries(
     // Get Cross Section of Livermore Rayleigh
     GGfloat kCS = LinearInterpolation(
       particle_cross_sections->energy_bins_[kEnergyID],
-      particle_cross_sections->photon_cross_sections_[RAYLEIGH_SCATTERING][kEnergyID + kNumberOfBins*material_id],
+      GetPhotonCrossSection(particle_cross_sections, RAYLEIGH_SCATTERING, kEnergyID, material_id),
       particle_cross_sections->energy_bins_[kEnergyID+1],
-      particle_cross_sections->photon_cross_sections_[RAYLEIGH_SCATTERING][kEnergyID+1 + kNumberOfBins*material_id],
+      GetPhotonCrossSection(particle_cross_sections, RAYLEIGH_SCATTERING, kEnergyID+1, material_id),
       kE0
     );
 
@@ -217,9 +216,9 @@ inline void LivermoreRayleighSampleSecondaries(
       GGuchar atomic_number_z = materials->atomic_number_Z_[kMixtureID+i];
       cross_section += materials->atomic_number_density_[kMixtureID+i] * LinearInterpolation(
         particle_cross_sections->energy_bins_[kEnergyID],
-        particle_cross_sections->photon_cross_sections_per_atom_[RAYLEIGH_SCATTERING][kEnergyID + kNumberOfBins*atomic_number_z],
+        GetPhotonCrossSectionPerAtom(particle_cross_sections, RAYLEIGH_SCATTERING, kEnergyID, atomic_number_z),
         particle_cross_sections->energy_bins_[kEnergyID+1],
-        particle_cross_sections->photon_cross_sections_per_atom_[RAYLEIGH_SCATTERING][kEnergyID+1 + kNumberOfBins*atomic_number_z],
+        GetPhotonCrossSectionPerAtom(particle_cross_sections, RAYLEIGH_SCATTERING, kEnergyID+1, atomic_number_z),
         kE0
       );
 
@@ -308,7 +307,7 @@ inline void LivermoreRayleighSampleSecondaries(
     printf("\n");
     printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Photon energy: %e keV\n", kE0/keV);
     printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Photon direction: %e %e %e\n", kGammaDirection.x, kGammaDirection.y, kGammaDirection.z);
-    printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Number of element in material %s: %d\n", particle_cross_sections->material_names_[material_id], materials->number_of_chemical_elements_[material_id]);
+    printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Number of element in material %u: %d\n", material_id, materials->number_of_chemical_elements_[material_id]);
     printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Selected element: %u\n", selected_atomic_number_z);
     printf("[GGEMS OpenCL function LivermoreRayleighSampleSecondaries]     Scattered photon direction: %e %e %e\n", primary_particle->dx_[particle_id], primary_particle->dy_[particle_id], primary_particle->dz_[particle_id]);
   }
@@ -40,6 +40,51 @@
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(PHILOX)
+/*!
+  \fn inline GGuint4 Philox4x32(GGuint4 counter, GGuint2 key)
+  \param counter - 128-bit counter
+  \param key - 64-bit key
+  \return 128 random bits
+  \brief Philox4x32-10 counter-based generator (Salmon et al., SC11), passes BigCrush in TestU01
+*/
+inline GGuint4 Philox4x32(GGuint4 counter, GGuint2 key)
+{
+  GGuint hi0 = 0, lo0 = 0, hi1 = 0, lo1 = 0;
+  for (GGint i = 0; i < 10; ++i) {
+    hi0 = mul_hi(0xD2511F53u, counter.x);
+    lo0 = 0xD2511F53u * counter.x;
+    hi1 = mul_hi(0xCD9E8D57u, counter.z);
+    lo1 = 0xCD9E8D57u * counter.z;
+    counter = (GGuint4)(hi1 ^ counter.y ^ key.x, lo1, hi0 ^ counter.w ^ key.y, lo0);
+    key.x += 0x9E3779B9u;
+    key.y += 0xBB67AE85u;
+  }
+  return counter;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat KissUniform(global GGEMSRandom* random, GGint const index)
+  \param random - pointer on random buffer on OpenCL device
+  \param index - index of thread
+  \return Uniform random float number in ]0,1[
+  \brief Philox engine replacing JKISS when kernels are compiled with PHILOX option, keyed on (seed, device) and counted on (draw, particle id). Only the draw counter is read and written in global memory
+*/
+inline GGfloat KissUniform(global GGEMSRandom* random, GGint const index)
+{
+  GGuint draw = random->prng_counter_[index];
+  random->prng_counter_[index] = draw + 1;
+
+  GGuint4 bits = Philox4x32((GGuint4)(draw, (GGuint)index, 0, 0), (GGuint2)(random->prng_key_[0], random->prng_key_[1]));
+
+  // 23 bits centered in the bin, x+0.5 is exact in float so the result is in [2^-24, 1-2^-24], never 0 or 1
+  return ((GGfloat)(bits.x >> 9) + 0.5f) * (1.0f/8388608.0f);
+}
+#else
 /*!
   \fn inline GGfloat KissUniform(global GGEMSRandom* random, GGint const index)
   \param random - pointer on random buffer on OpenCL device
@@ -73,6 +118,7 @@ inline GGfloat KissUniform(global GGEMSRandom* random, GGint const index)
     //  UINT_MAX       1.0  - float32_precision
     / 4294967295.0) * (1.0f - 1.0f/(1<<23));
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,11 +89,26 @@ class GGEMS_EXPORT GGEMSPseudoRandomGenerator
 
     /*!
       \fn void SetSeed(GGuint const& seed)
-      \param seed - seed of random
-      \brief set the initial seed
+      \param seed - seed of random, 0 to generate a seed
+      \brief set a new seed after initialization, random streams of all devices restart from this seed
     */
     void SetSeed(GGuint const& seed);
 
+    /*!
+      \fn void SetEngine(std::string const& engine)
+      \param engine - name of random engine, 'jkiss' (default) or 'philox'
+      \brief set the random engine used by OpenCL kernels
+    */
+    void SetEngine(std::string const& engine);
+
+    /*!
+      \fn GGsize GetBufferSize(GGsize const& particle_capacity) const
+      \param particle_capacity - number of particles in buffer
+      \return size in bytes of a random buffer
+      \brief compute the size of a random buffer for the selected engine and a capacity chosen at runtime
+    */
+    GGsize GetBufferSize(GGsize const& particle_capacity) const;
+
     /*!
       \fn void PrintInfos(void) const
       \brief printing infos about random
@@ -121,6 +136,12 @@ class GGEMS_EXPORT GGEMSPseudoRandomGenerator
     */
     void InitializeSeeds(void);
 
+    /*!
+      \fn void InitializePhiloxKeys(void)
+      \brief Initialize keys and reset draw counters for Philox random
+    */
+    void InitializePhiloxKeys(void);
+
     /*!
       \fn GGuint GenerateSeed(void) const
       \return the seed computed by GGEMS
@@ -132,6 +153,8 @@ class GGEMS_EXPORT GGEMSPseudoRandomGenerator
     cl::Buffer** pseudo_random_numbers_; /*!< Pointer storing the buffer about random numbers in activated device */
     GGsize number_activated_devices_; /*!< Number of activated device */
     GGuint seed_; /*!< Initial seed generating state of GGEMS random */
+    bool is_philox_; /*!< Flag for counter-based Philox engine instead of JKISS */
+    GGsize random_size_; /*!< Size of random buffer on each device depending on engine */
 };
 
 #endif // End of GUARD_GGEMS_RANDOMS_PSEUDO_RANDOM_GENERATOR_HH
@@ -34,6 +34,19 @@
 #include "GGEMS/global/GGEMSConfiguration.hh"
 #include "GGEMS/tools/GGEMSTypes.hh"
 
+/*!
+  \struct GGEMSPhiloxRandom_t
+  \brief Structure storing informations about counter-based Philox random, the state of the engine is only a draw counter for each particle
+*/
+typedef struct GGEMSPhiloxRandom_t
+{
+  GGuint prng_key_[2]; /*!< Key of the Philox engine, seed of simulation and index of device */
+  GGuint prng_counter_[MAXIMUM_PARTICLES]; /*!< Number of draws done by each particle slot */
+} GGEMSPhiloxRandom; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#if defined(__OPENCL_C_VERSION__) && defined(PHILOX)
+typedef GGEMSPhiloxRandom GGEMSRandom; /*!< Kernels compiled with Philox engine see only the counter and the key */
+#else
 /*!
   \struct GGEMSRandom_t
   \brief Structure storing informations about random
@@ -46,5 +59,6 @@ typedef struct GGEMSRandom_t
   GGuint prng_state_4_[MAXIMUM_PARTICLES]; /*!< State 4 of the prng */
   GGuint prng_state_5_[MAXIMUM_PARTICLES]; /*!< State 5 of the prng */
 } GGEMSRandom; /*!< Using C convention name of struct to C++ (_t deletion) */
+#endif
 
 #endif // End of GUARD_GGEMS_RANDOMS_GGEMSRANDOM_HH
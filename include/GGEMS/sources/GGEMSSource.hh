@@ -31,6 +31,8 @@
   \date Tuesday October 15, 2019
 */
 
+#include <atomic>
+
 #include "GGEMS/global/GGEMSOpenCLManager.hh"
 
 class GGEMSParticles;
@@ -117,6 +119,13 @@ class GGEMS_EXPORT GGEMSSource
     */
     void SetRotation(GGfloat const& rx, GGfloat const& ry, GGfloat const& rz, std::string const& unit = "deg");
 
+    /*!
+      \fn void RotateGantry(GGfloat const& angle)
+      \param angle - rotation angle around Z axis (isocenter) in radian
+      \brief rotate the source around isocenter, composed with the current position and orientation on each device
+    */
+    void RotateGantry(GGfloat const& angle);
+
     /*!
       \fn void SetNumberOfParticles(GGsize const& number_of_particles)
       \param number_of_particles - number of particles to simulate
@@ -124,6 +133,13 @@ class GGEMS_EXPORT GGEMSSource
     */
     void SetNumberOfParticles(GGsize const& number_of_particles);
 
+    /*!
+      \fn void SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs)
+      \param minimum_number_of_batchs - minimum number of batchs of a run, all devices included
+      \brief Set the minimum number of batchs, particles are split in smaller batchs of close sizes if necessary
+    */
+    void SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs);
+
     /*!
       \fn void EnableTracking(void)
       \brief Enabling tracking infos during simulation
@@ -154,6 +170,27 @@ class GGEMS_EXPORT GGEMSSource
     */
     inline GGsize GetNumberOfParticlesInBatch(GGsize const& device_index, GGsize const& batch_index) {return number_of_particles_in_batch_[device_index][batch_index];}
 
+    /*!
+      \fn inline GGsize GetNumberOfSharedBatchs(void) const
+      \return the number of batchs shared by all devices
+      \brief method returning the number of batchs in work-queue mode
+    */
+    inline GGsize GetNumberOfSharedBatchs(void) const {return number_of_shared_batchs_;}
+
+    /*!
+      \fn bool PullBatch(GGsize& number_of_particles)
+      \param number_of_particles - number of particles in pulled batch
+      \return false if all batchs have already been pulled
+      \brief pull the next batch shared by all devices, thread-safe
+    */
+    bool PullBatch(GGsize& number_of_particles);
+
+    /*!
+      \fn void ResetSharedBatchs(void)
+      \brief make all shared batchs available again
+    */
+    void ResetSharedBatchs(void);
+
     /*!
       \fn void CheckParameters(void) const
       \brief Check mandatory parameters for a source
@@ -167,6 +204,12 @@ class GGEMS_EXPORT GGEMSSource
     */
     virtual void Initialize(bool const& is_tracking = false);
 
+    /*!
+      \fn void Update(void)
+      \brief Take into account parameters modified since previous run (number of particles, energy...), kernels are not compiled again
+    */
+    virtual void Update(void);
+
     /*!
       \fn void GetPrimaries(GGsize const& thread_index, GGsize const& number_of particles) = 0
       \param thread_index - index of activated device (thread index)
@@ -195,6 +238,12 @@ class GGEMS_EXPORT GGEMSSource
     */
     void OrganizeParticlesInBatch(void);
 
+    /*!
+      \fn void DeleteBatchs(void)
+      \brief Delete the particles organized in batch
+    */
+    void DeleteBatchs(void);
+
   protected:
     std::string source_name_; /*!< Name of the source */
     GGsize number_of_particles_; /*!< Number of particles */
@@ -203,6 +252,10 @@ class GGEMS_EXPORT GGEMSSource
     GGsize** number_of_particles_in_batch_; /*!< Number of particles in batch for each device */
     GGsize* number_of_batchs_; /*!< Number of batchs for each device */
 
+    GGsize number_of_shared_batchs_; /*!< Number of batchs shared by all devices in work-queue mode */
+    GGsize minimum_number_of_batchs_; /*!< Minimum number of batchs of a run, all devices included */
+    std::atomic<GGsize> next_shared_batch_; /*!< Index of next batch pulled by a device in work-queue mode */
+
     GGchar particle_type_; /*!< Type of particle: photon, electron or positron */
     std::string tracking_kernel_option_; /*!< Preprocessor option for tracking */
     GGEMSGeometryTransformation* geometry_transformation_; /*!< Pointer storing the geometry transformation */
@@ -127,6 +127,19 @@ class GGEMS_EXPORT GGEMSSourceManager
     */
     void Initialize(GGuint const& seed, bool const& is_tracking = false, GGint const& particle_tracking_id = 0) const;
 
+    /*!
+      \fn void Update(void) const
+      \brief Update all sources with parameters modified since previous run
+    */
+    void Update(void) const;
+
+    /*!
+      \fn void SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs) const
+      \param minimum_number_of_batchs - minimum number of batchs of a run, all devices included
+      \brief Set the minimum number of batchs of all sources, before initializing or updating them
+    */
+    void SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs) const;
+
     /*!
       \fn inline std::string GetNameOfSource(GGsize const& source_index) const
       \param source_index - index of the source
@@ -151,6 +164,35 @@ class GGEMS_EXPORT GGEMSSourceManager
     */
     GGsize GetTotalNumberOfBatchs(void) const;
 
+    /*!
+      \fn GGsize GetTotalNumberOfSharedBatchs(void) const
+      \return total number of batch shared by devices for whole simulation
+      \brief compute the total number of batchs in work-queue mode
+    */
+    GGsize GetTotalNumberOfSharedBatchs(void) const;
+
+    /*!
+      \fn inline bool PullBatch(GGsize const& source_index, GGsize& number_of_particles)
+      \param source_index - index of the source
+      \param number_of_particles - number of particles in pulled batch
+      \return false if all batchs of the source have already been pulled
+      \brief pull the next batch of a source shared by all devices
+    */
+    inline bool PullBatch(GGsize const& source_index, GGsize& number_of_particles) {return sources_[source_index]->PullBatch(number_of_particles);}
+
+    /*!
+      \fn void ResetSharedBatchs(void) const
+      \brief make shared batchs of all sources available again for a new run
+    */
+    void ResetSharedBatchs(void) const;
+
+    /*!
+      \fn void RotateGantry(GGfloat const& angle) const
+      \param angle - rotation angle around Z axis (isocenter) in radian
+      \brief rotate all the sources with the gantry
+    */
+    void RotateGantry(GGfloat const& angle) const;
+
     /*!
       \fn inline GGsize GetNumberOfParticlesInBatch(GGsize const& source_index, GGsize const& thread_index, GGsize const& batch_index)
       \param source_index - index of the source
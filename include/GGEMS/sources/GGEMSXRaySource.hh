@@ -119,6 +119,12 @@ class GGEMS_EXPORT GGEMSXRaySource : public GGEMSSource
     */
     void Initialize(bool const& is_tracking = false) override;
 
+    /*!
+      \fn void Update(void) override
+      \brief Update particles in batch and energy spectrum modified since previous run
+    */
+    void Update(void) override;
+
     /*!
       \fn void PrintInfos(void) const
       \brief Printing infos about the source
@@ -146,6 +152,12 @@ class GGEMS_EXPORT GGEMSXRaySource : public GGEMSSource
     */
     void FillEnergy(void);
 
+    /*!
+      \fn void ReleaseEnergy(void)
+      \brief deallocate energy spectrum and cdf on each device
+    */
+    void ReleaseEnergy(void);
+
     /*!
       \fn void CheckParameters(void) const
       \brief Check mandatory parameters for a source
@@ -153,6 +153,12 @@ class GGEMS_EXPORT GGEMSStream
     */
     void SetVerbosity(GGint const& verbosity_limit);
 
+    /*!
+      \fn static void MuteThread(void)
+      \brief Mute all GGEMS streams in calling thread, used by host worker threads
+    */
+    static void MuteThread(void);
+
   private:
     std::string class_name_; /*!< Name of the class to print */
     std::string method_name_; /*!< Name of the method to print */
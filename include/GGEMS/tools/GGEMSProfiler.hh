@@ -58,11 +58,11 @@ class GGEMS_EXPORT GGEMSProfiler
     void HandleEvent(cl::Event& event);
 
     /*!
-      \fn inline DurationNano GetSummaryTime(void) const
-      \brief get elapsed time in ns in OpenCL operation
-      \return elapsed time in ns
+      \fn DurationNano GetSummaryTime(void) const
+      \brief get elapsed time in ns in OpenCL operation, locked against events completing in call back function
+      \return elapsed time in ns, 0 if no event completed yet
     */
-    inline DurationNano GetSummaryTime(void) const {return profiler_item_->GetElapsedTime();}
+    DurationNano GetSummaryTime(void) const;
 
   private:
     /*!
@@ -36,9 +36,11 @@
 #endif
 
 #include <unordered_map>
+#include <map>
 #include "GGEMS/tools/GGEMSProfiler.hh"
 
 typedef std::unordered_map<std::string, GGEMSProfiler> ProfilerUMap; /*!< Unordered map with key : name of profile, profile object */
+typedef std::map<std::string, DurationNano> ProfileTimeMap; /*!< Map with key : name of profile, elapsed time sorted by name */
 
 /*!
   \class GGEMSProfilerManager
@@ -111,6 +113,13 @@ class GGEMS_EXPORT GGEMSProfilerManager
     */
     void PrintSummaryProfile(void) const;
 
+    /*!
+      \fn ProfileTimeMap GetSummaryProfile(void) const
+      \return elapsed time of each profile sorted by name
+      \brief get summary profile, for benchmark or external reporting
+    */
+    ProfileTimeMap GetSummaryProfile(void) const;
+
     /*!
       \fn void Reset(void)
       \brief reset all profile already registered
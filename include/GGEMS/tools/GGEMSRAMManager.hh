@@ -132,6 +132,14 @@ class GGEMS_EXPORT GGEMSRAMManager
       else return false;
     }
 
+    /*!
+      \fn inline GGsize GetAllocatedRAMMemory(GGsize const& index) const
+      \param index - index of device
+      \return size in bytes of allocated buffers
+      \brief Get the RAM memory already allocated by GGEMS on device
+    */
+    inline GGsize GetAllocatedRAMMemory(GGsize const& index) const {return allocated_ram_[index];}
+
     /*!
       \fn void IncrementRAMMemory(std::string const& class_name, GGsize const& index, GGsize const& size)
       \param class_name - name of class allocating memory
@@ -33,6 +33,7 @@
 
 #include <fstream>
 #include <cmath>
+#include <functional>
 
 #include "GGEMS/global/GGEMSConfiguration.hh"
 #include "GGEMS/tools/GGEMSTypes.hh"
@@ -63,9 +64,26 @@ namespace GGEMSMisc
     \param class_name - Name of the class
     \param method_name - Name of the methode or function
     \param message - Message to print for the exception
-    \brief Throw a C++ exception
+    \brief Print the message and throw a C++ exception carrying it
   */
   [[noreturn]] void ThrowException(std::string const& class_name, std::string const& method_name, std::string const& message);
+
+  /*!
+    \fn std::string HashContent(std::string const& content)
+    \param content - content to hash
+    \return FNV-1a 64 bits hash of content in 16 hexadecimal characters
+    \brief hash a content, used to name files in GGEMS caches
+  */
+  std::string HashContent(std::string const& content);
+
+  /*!
+    \fn void ParallelFor(GGsize const& number_of_tasks, GGsize const& number_of_threads, std::function<void(GGsize const&)> const& task)
+    \param number_of_tasks - number of independent tasks
+    \param number_of_threads - maximum number of host threads, calling thread included
+    \param task - function called with the index of each task
+    \brief run independent tasks on host threads, messages from additional threads are muted, the first exception is printed and thrown again in calling thread
+  */
+  void ParallelFor(GGsize const& number_of_tasks, GGsize const& number_of_threads, std::function<void(GGsize const&)> const& task);
 }
 
 #endif // End of GUARD_GGEMS_TOOLS_GGEMSTOOLS_HH
@@ -34,6 +34,9 @@
 #define FALSE 0 /*!< False for OpenCL */
 #define TRUE 1 /*!< True for OpenCL */
 
+#define DOSIMETRY_FIXED_POINT_SCALE 4294967296.0f /*!< Number of fixed-point units in 1 MeV, up to 4.29e9 MeV by dosel */
+#define DOSIMETRY_FIXED_POINT_SQUARED_SCALE 16777216.0f /*!< Number of fixed-point units in 1 MeV2 for squared energy, up to 1.1e12 MeV2 by dosel */
+
 #ifdef _MSC_VER
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -139,6 +142,21 @@
 #define GGDosiType GGfloat /*!< define GGDositype as a float, useful for dosimetry computation */
 #endif
 
+#ifdef DOSIMETRY_FIXED_POINT
+#define GGDosiTallyType GGulong /*!< define GGDosiTallyType as an unsigned long, energy deposits accumulated in fixed-point unit */
+#if defined(cl_khr_int64_base_atomics)
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+#endif
+#else
+#define GGDosiTallyType GGDosiType /*!< define GGDosiTallyType as GGDosiType, energy deposits accumulated in floating point */
+#endif
+
+#ifdef LABEL_16BIT
+#define GGLabelType GGushort /*!< define GGLabelType as an unsigned short, label volume storing more than 255 materials */
+#else
+#define GGLabelType GGuchar /*!< define GGLabelType as an unsigned char, label volume storing up to 255 materials */
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -193,6 +211,136 @@ inline void AtomicAddDouble(volatile global GGDosiType* address, GGdouble val)
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void AtomicAddULong(volatile global GGulong* address, GGulong val)
+  \param address - address of pointer where the value is added
+  \param val - unsigned long value to add
+  \brief atomic addition for 64 bits integer, emulated with two 32 bits atomics if int64 atomics are not available
+*/
+inline void AtomicAddULong(volatile global GGulong* address, GGulong val)
+{
+  #if defined(cl_khr_int64_base_atomics)
+  atom_add(address, val);
+  #else
+  // Carry of low word is propagated to high word, final sum is exact whatever the order of additions
+  #ifdef __ENDIAN_LITTLE__
+  volatile global GGuint* low_word = (volatile global GGuint*)address;
+  volatile global GGuint* high_word = low_word + 1;
+  #else
+  volatile global GGuint* high_word = (volatile global GGuint*)address;
+  volatile global GGuint* low_word = high_word + 1;
+  #endif
+
+  GGuint low = (GGuint)val;
+  GGuint high = (GGuint)(val >> 32);
+
+  GGuint previous_low = atomic_add(low_word, low);
+  if (previous_low + low < previous_low) ++high;
+  if (high) atomic_add(high_word, high);
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGDosiTallyType ConvertDoseToTally(GGDosiType val)
+  \param val - energy to record
+  \return value in tally unit
+  \brief convert an energy to tally unit, fixed-point unit rounded to nearest or unchanged
+*/
+inline GGDosiTallyType ConvertDoseToTally(GGDosiType val)
+{
+  #ifdef DOSIMETRY_FIXED_POINT
+  return convert_ulong_sat_rte(val * DOSIMETRY_FIXED_POINT_SCALE);
+  #else
+  return val;
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGDosiType ConvertTallyToDose(GGDosiTallyType val)
+  \param val - value in tally unit
+  \return energy
+  \brief convert a tally value to energy
+*/
+inline GGDosiType ConvertTallyToDose(GGDosiTallyType val)
+{
+  #ifdef DOSIMETRY_FIXED_POINT
+  return (GGDosiType)val / DOSIMETRY_FIXED_POINT_SCALE;
+  #else
+  return val;
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGDosiTallyType ConvertSquaredDoseToTally(GGDosiType val)
+  \param val - squared energy to record
+  \return value in tally unit
+  \brief convert a squared energy to tally unit, coarser fixed-point unit so sums of squared batch deposits do not overflow
+*/
+inline GGDosiTallyType ConvertSquaredDoseToTally(GGDosiType val)
+{
+  #ifdef DOSIMETRY_FIXED_POINT
+  return convert_ulong_sat_rte(val * DOSIMETRY_FIXED_POINT_SQUARED_SCALE);
+  #else
+  return val;
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGDosiType ConvertTallyToSquaredDose(GGDosiTallyType val)
+  \param val - value in tally unit
+  \return squared energy
+  \brief convert a squared energy tally value to squared energy
+*/
+inline GGDosiType ConvertTallyToSquaredDose(GGDosiTallyType val)
+{
+  #ifdef DOSIMETRY_FIXED_POINT
+  return (GGDosiType)val / DOSIMETRY_FIXED_POINT_SQUARED_SCALE;
+  #else
+  return val;
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void AtomicAddTally(volatile global GGDosiTallyType* address, GGDosiTallyType val)
+  \param address - address of tally where the value is added
+  \param val - value in tally unit
+  \brief atomic addition in tally, integer addition in fixed-point mode is bit-reproducible
+*/
+inline void AtomicAddTally(volatile global GGDosiTallyType* address, GGDosiTallyType val)
+{
+  #if defined(DOSIMETRY_FIXED_POINT)
+  AtomicAddULong(address, val);
+  #elif defined(DOSIMETRY_DOUBLE_PRECISION)
+  AtomicAddDouble(address, val);
+  #else
+  AtomicAddFloat(address, val);
+  #endif
+}
+
 #else
 
 #ifdef OPENGL_VISUALIZATION
@@ -73,9 +73,30 @@ class GGEMS(object):
         ggems_lib.set_tracking_ggems.argtypes = [ctypes.c_void_p, ctypes.c_bool, ctypes.c_int]
         ggems_lib.set_tracking_ggems.restype = ctypes.c_void_p
 
-        ggems_lib.run_ggems.argtypes = [ctypes.c_void_p]
+        ggems_lib.set_asynchronous_stepping_ggems.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_asynchronous_stepping_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.set_particle_compaction_ggems.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_particle_compaction_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.set_random_engine_ggems.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        ggems_lib.set_random_engine_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.set_dynamic_load_balancing_ggems.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_dynamic_load_balancing_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.set_tally_accumulation_ggems.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_tally_accumulation_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.set_particle_batch_size_ggems.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        ggems_lib.set_particle_batch_size_ggems.restype = ctypes.c_void_p
+
+        ggems_lib.run_ggems.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
         ggems_lib.run_ggems.restype = ctypes.c_void_p
 
+        ggems_lib.run_gantry_sweep_ggems.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.run_gantry_sweep_ggems.restype = ctypes.c_void_p
+
         self.obj = ggems_lib.create_ggems()
 
     def delete(self):
@@ -84,8 +105,11 @@ class GGEMS(object):
     def initialize(self, seed = 0):
         ggems_lib.initialize_ggems(self.obj, seed)
 
-    def run(self):
-        ggems_lib.run_ggems(self.obj)
+    def run(self, seed = 0):
+        ggems_lib.run_ggems(self.obj, seed)
+
+    def run_gantry_sweep(self, number_of_projections, angle_step, unit = 'deg'):
+        ggems_lib.run_gantry_sweep_ggems(self.obj, number_of_projections, angle_step, unit.encode('ASCII'))
 
     def opencl_verbose(self, flag):
         ggems_lib.set_opencl_verbose_ggems(self.obj, flag)
@@ -117,6 +141,24 @@ class GGEMS(object):
     def tracking_verbose(self, flag, particle_id):
         ggems_lib.set_tracking_ggems(self.obj, flag, particle_id)
 
+    def asynchronous_stepping(self, flag):
+        ggems_lib.set_asynchronous_stepping_ggems(self.obj, flag)
+
+    def particle_compaction(self, flag):
+        ggems_lib.set_particle_compaction_ggems(self.obj, flag)
+
+    def random_engine(self, engine):
+        ggems_lib.set_random_engine_ggems(self.obj, engine.encode('ASCII'))
+
+    def dynamic_load_balancing(self, flag):
+        ggems_lib.set_dynamic_load_balancing_ggems(self.obj, flag)
+
+    def tally_accumulation(self, flag):
+        ggems_lib.set_tally_accumulation_ggems(self.obj, flag)
+
+    def particle_batch_size(self, size):
+        ggems_lib.set_particle_batch_size_ggems(self.obj, size)
+
 
 def clean_safely():
     GGEMSOpenCLManager().clean()
@@ -48,6 +48,15 @@ class GGEMSDosimetryCalculator(object):
         ggems_lib.dose_tle_navigator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         ggems_lib.dose_tle_navigator.restype = ctypes.c_void_p
 
+        ggems_lib.dose_local_tally_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_local_tally_dosimetry_calculator.restype = ctypes.c_void_p
+
+        ggems_lib.dose_fixed_point_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_fixed_point_dosimetry_calculator.restype = ctypes.c_void_p
+
+        ggems_lib.dose_batch_uncertainty_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_batch_uncertainty_dosimetry_calculator.restype = ctypes.c_void_p
+
         ggems_lib.delete_dosimetry_calculator.argtypes = [ctypes.c_void_p]
         ggems_lib.delete_dosimetry_calculator.restype = ctypes.c_void_p
 
@@ -92,6 +101,15 @@ class GGEMSDosimetryCalculator(object):
     def set_tle(self, activate):
         ggems_lib.dose_tle_navigator(self.obj, activate)
 
+    def set_local_tally(self, activate):
+        ggems_lib.dose_local_tally_dosimetry_calculator(self.obj, activate)
+
+    def set_fixed_point(self, activate):
+        ggems_lib.dose_fixed_point_dosimetry_calculator(self.obj, activate)
+
+    def set_batch_uncertainty(self, activate):
+        ggems_lib.dose_batch_uncertainty_dosimetry_calculator(self.obj, activate)
+
     def scale_factor(self, scale):
         ggems_lib.scale_factor_dosimetry_calculator(self.obj, scale)
 
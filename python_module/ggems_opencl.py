@@ -39,6 +39,12 @@ class GGEMSOpenCLManager(object):
         ggems_lib.set_device_balancing_opencl_manager.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
         ggems_lib.set_device_balancing_opencl_manager.restype = ctypes.c_void_p
 
+        ggems_lib.set_kernel_cache_directory_opencl_manager.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        ggems_lib.set_kernel_cache_directory_opencl_manager.restype = ctypes.c_void_p
+
+        ggems_lib.set_work_group_tuning_opencl_manager.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_work_group_tuning_opencl_manager.restype = ctypes.c_void_p
+
         self.obj = ggems_lib.get_instance_ggems_opencl_manager()
 
     def print_infos(self):
@@ -53,5 +59,11 @@ class GGEMSOpenCLManager(object):
     def set_device_balancing(self, device_balancing):
         ggems_lib.set_device_balancing_opencl_manager(self.obj, device_balancing.encode('ASCII'))
 
+    def set_kernel_cache_directory(self, directory):
+        ggems_lib.set_kernel_cache_directory_opencl_manager(self.obj, directory.encode('ASCII'))
+
+    def set_work_group_tuning(self, flag):
+        ggems_lib.set_work_group_tuning_opencl_manager(self.obj, flag)
+
     def clean(self):
         ggems_lib.clean_opencl_manager(self.obj)
@@ -45,6 +45,9 @@ class GGEMSVoxelizedPhantom(object):
         ggems_lib.set_rotation_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
         ggems_lib.set_rotation_ggems_voxelized_phantom.restype = ctypes.c_void_p
 
+        ggems_lib.set_woodcock_tracking_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.set_woodcock_tracking_ggems_voxelized_phantom.restype = ctypes.c_void_p
+
         self.obj = ggems_lib.create_ggems_voxelized_phantom(voxelized_phantom_name.encode('ASCII'))
 
     def set_phantom(self, phantom_filename, range_data_filename):
@@ -68,6 +71,9 @@ class GGEMSVoxelizedPhantom(object):
     def set_rotation(self, rx, ry, rz, unit):
         ggems_lib.set_rotation_ggems_voxelized_phantom(self.obj, rx, ry, rz, unit.encode('ASCII'))
 
+    def set_woodcock_tracking(self, flag):
+        ggems_lib.set_woodcock_tracking_ggems_voxelized_phantom(self.obj, flag)
+
 
 class GGEMSWorld(object):
     """Class for world volume for GGEMS simulation
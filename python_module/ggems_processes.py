@@ -94,6 +94,12 @@ class GGEMSProcessesManager(object):
         ggems_lib.print_tables_processes_manager.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         ggems_lib.print_tables_processes_manager.restype = ctypes.c_void_p
 
+        ggems_lib.set_physic_tables_cache_directory_processes_manager.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        ggems_lib.set_physic_tables_cache_directory_processes_manager.restype = ctypes.c_void_p
+
+        ggems_lib.set_number_of_host_threads_processes_manager.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        ggems_lib.set_number_of_host_threads_processes_manager.restype = ctypes.c_void_p
+
         self.obj = ggems_lib.get_instance_processes_manager()
 
     def set_cross_section_table_number_of_bins(self, number_of_bins):
@@ -115,4 +121,10 @@ class GGEMSProcessesManager(object):
         ggems_lib.add_process_processes_manager(self.obj, process_name.encode('ASCII'), particle_name.encode('ASCII'), phantom_name.encode('ASCII'), is_secondary)
 
     def print_tables(self, flag):
-        ggems_lib.print_tables_processes_manager(self.obj, flag)
\ No newline at end of file
+        ggems_lib.print_tables_processes_manager(self.obj, flag)
+
+    def set_physic_tables_cache_directory(self, directory):
+        ggems_lib.set_physic_tables_cache_directory_processes_manager(self.obj, directory.encode('ASCII'))
+
+    def set_number_of_host_threads(self, number_of_threads):
+        ggems_lib.set_number_of_host_threads_processes_manager(self.obj, number_of_threads)
\ No newline at end of file
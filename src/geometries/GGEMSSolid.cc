@@ -42,7 +42,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 GGEMSSolid::GGEMSSolid(void)
-: number_of_voxels_(0), 
+: number_of_voxels_(0),
+  label_size_(sizeof(GGuchar)),
   kernel_option_("")
 {
   GGcout("GGEMSSolid", "GGEMSSolid", 3) << "GGEMSSolid creating..." << GGendl;
@@ -103,7 +104,7 @@ GGEMSSolid::~GGEMSSolid(void)
 
   if (label_data_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(label_data_[i], number_of_voxels_*sizeof(GGuchar), i);
+      opencl_manager.Deallocate(label_data_[i], number_of_voxels_*label_size_, i);
     }
     delete[] label_data_;
     label_data_ = nullptr;
@@ -135,7 +136,7 @@ void GGEMSSolid::EnableTracking(void)
 
 void GGEMSSolid::AddKernelOption(std::string const& option)
 {
-  kernel_option_ += " -DTLE";
+  kernel_option_ += option;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
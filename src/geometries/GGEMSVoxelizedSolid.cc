@@ -123,9 +123,9 @@ void GGEMSVoxelizedSolid::Initialize(GGEMSMaterials* materials)
 {
   GGcout("GGEMSVoxelizedSolid", "Initialize", 3) << "Initializing voxelized solid..." << GGendl;
 
-  // Initializing kernels and loading image
-  InitializeKernel();
+  // Loading image and initializing kernels, label type is known after loading image
   LoadVolumeImage(materials);
+  InitializeKernel();
 
   // Creating volume for OpenGL
   // Get some infos for grid
@@ -151,7 +151,7 @@ void GGEMSVoxelizedSolid::Initialize(GGEMSMaterials* materials)
     opencl_manager.ReleaseDeviceBuffer(solid_data_[0], solid_data_device, 0);
 
     // Loading labels and materials for OpenGL
-    opengl_solid_->SetMaterial(materials, label_data_[0], number_of_voxels_);
+    opengl_solid_->SetMaterial(materials, label_data_[0], number_of_voxels_, label_size_);
   }
   #endif
 }
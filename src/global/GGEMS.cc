@@ -75,7 +75,14 @@ GGEMS::GGEMS(void)
   is_random_verbose_(false),
   is_tracking_verbose_(false),
   is_profiling_verbose_(false),
-  particle_tracking_id_(0)
+  particle_tracking_id_(0),
+  is_asynchronous_stepping_(true),
+  is_particle_compaction_(false),
+  is_dynamic_load_balancing_(false),
+  progress_bar_(nullptr),
+  is_tally_accumulation_(false),
+  number_of_runs_(0),
+  particle_batch_size_(MAXIMUM_PARTICLES)
 {
   GGcout("GGEMS", "GGEMS", 3) << "GGEMS creating..." << GGendl;
 
@@ -188,6 +195,110 @@ void GGEMS::SetTrackingVerbose(bool const& is_tracking_verbose, GGint const& par
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMS::SetAsynchronousStepping(bool const& is_asynchronous_stepping)
+{
+  is_asynchronous_stepping_ = is_asynchronous_stepping;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::SetParticleCompaction(bool const& is_particle_compaction)
+{
+  is_particle_compaction_ = is_particle_compaction;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::SetRandomEngine(std::string const& random_engine)
+{
+  GGEMSSourceManager::GetInstance().GetPseudoRandomGenerator()->SetEngine(random_engine);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::SetDynamicLoadBalancing(bool const& is_dynamic_load_balancing)
+{
+  is_dynamic_load_balancing_ = is_dynamic_load_balancing;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::SetTallyAccumulation(bool const& is_tally_accumulation)
+{
+  is_tally_accumulation_ = is_tally_accumulation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::SetParticleBatchSize(GGsize const& particle_batch_size)
+{
+  particle_batch_size_ = particle_batch_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMS::ComputeParticleBatchSize(void) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  GGEMSRAMManager& ram_manager = GGEMSRAMManager::GetInstance();
+
+  // Memory used by one particle, a second particle buffer is used by compaction
+  GGEMSParticles* particles = source_manager.GetParticles();
+  GGEMSPseudoRandomGenerator* random = source_manager.GetPseudoRandomGenerator();
+  GGsize particle_header_size = particles->GetBufferSize(0);
+  GGsize random_header_size = random->GetBufferSize(0);
+  GGsize particle_size = particles->GetBufferSize(1) - particle_header_size;
+  GGsize random_size = random->GetBufferSize(1) - random_header_size;
+  GGsize number_of_particle_buffers = is_particle_compaction_ ? 2 : 1;
+  GGsize memory_by_particle = number_of_particle_buffers * particle_size + random_size;
+
+  GGsize particle_batch_size = 0;
+  for (GGsize i = 0; i < opencl_manager.GetNumberOfActivatedDevice(); ++i) {
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(i);
+
+    // Tallies, geometries and tables are allocated after kernel compilation, only a quarter of free memory is given to particles
+    GGsize free_memory = opencl_manager.GetRAMMemory(device_index) - ram_manager.GetAllocatedRAMMemory(device_index);
+    GGsize particle_memory = free_memory / 4;
+    GGsize header_memory = number_of_particle_buffers * particle_header_size + random_header_size;
+    GGsize device_batch_size = particle_memory > header_memory ? (particle_memory - header_memory) / memory_by_particle : 0;
+
+    // Each buffer is allocated in one piece
+    GGsize max_buffer_size = opencl_manager.GetMaxBufferAllocationSize(device_index);
+    GGsize max_particle_batch_size = (max_buffer_size - particle_header_size) / particle_size;
+    GGsize max_random_batch_size = (max_buffer_size - random_header_size) / random_size;
+    if (device_batch_size > max_particle_batch_size) device_batch_size = max_particle_batch_size;
+    if (device_batch_size > max_random_batch_size) device_batch_size = max_random_batch_size;
+
+    if (i == 0 || device_batch_size < particle_batch_size) particle_batch_size = device_batch_size;
+  }
+
+  // Multiple of work group size, at least one work group of particles
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  particle_batch_size -= particle_batch_size % work_group_size;
+  if (particle_batch_size < work_group_size) particle_batch_size = work_group_size;
+
+  GGcout("GGEMS", "ComputeParticleBatchSize", 1) << "Particle batch size computed from device memory: " << particle_batch_size << GGendl;
+
+  return particle_batch_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMS::Initialize(GGuint const& seed)
 {
   GGcout("GGEMS", "Initialize", 1) << "Initialization of GGEMS Manager singleton..." << GGendl;
@@ -214,9 +325,30 @@ void GGEMS::Initialize(GGuint const& seed)
   // Checking if material manager is ready
   if (!material_database_manager.IsReady()) GGEMSMisc::ThrowException("GGEMS", "Initialize", "Materials are not loaded in GGEMS!!!");
 
+  // Capacity of particle buffers is given to kernels, so it is fixed before compiling any kernel using particles
+  opencl_manager.SetParticleCapacity(particle_batch_size_ == 0 ? ComputeParticleBatchSize() : particle_batch_size_);
+
+  // Uncertainty computed batch by batch needs enough batchs
+  source_manager.SetMinimumNumberOfBatchs(navigator_manager.GetMinimumNumberOfBatchs());
+
   // Initialization of the source
   source_manager.Initialize(seed, is_tracking_verbose_, particle_tracking_id_);
 
+  // Compaction of particles, index of particle has to be kept for tracking and OpenGL
+  if (is_particle_compaction_) {
+    bool is_particle_index_kept = is_tracking_verbose_;
+    #ifdef OPENGL_VISUALIZATION
+    is_particle_index_kept = is_particle_index_kept || opengl_manager.IsOpenGLActivated();
+    #endif
+
+    if (is_particle_index_kept) {
+      GGwarn("GGEMS", "Initialize", 0) << "Compaction of particles is not used with tracking or OpenGL visualization!!!" << GGendl;
+    }
+    else {
+      source_manager.GetParticles()->EnableCompaction();
+    }
+  }
+
   // Initialization of the navigators (phantom + system)
   navigator_manager.Initialize(is_tracking_verbose_);
 
@@ -295,74 +427,97 @@ void GGEMS::Initialize(GGuint const& seed)
 void GGEMS::RunOnDevice(GGsize const& thread_index)
 {
   GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
-  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
-
-  #ifdef OPENGL_VISUALIZATION
-  GGEMSOpenGLManager& opengl_manager = GGEMSOpenGLManager::GetInstance();
-  #endif
-
-  // Printing progress bar
-  mutex.lock();
-  static GGEMSProgressBar progress_bar(source_manager.GetTotalNumberOfBatchs());
-  mutex.unlock();
 
   // Loop over sources
   for (GGsize i = 0; i < source_manager.GetNumberOfSources(); ++i) {
-    // Number of batch for a source
-    GGsize number_of_batchs = source_manager.GetNumberOfBatchs(i, thread_index);
+    if (is_dynamic_load_balancing_) {
+      // Pulling batchs from the shared counter of the source until all particles are simulated
+      GGsize number_of_particles = 0;
+      while (source_manager.PullBatch(i, number_of_particles)) {
+        RunBatch(i, thread_index, number_of_particles);
+
+        // Incrementing progress bar
+        mutex.lock();
+        ++(*progress_bar_);
+        mutex.unlock();
+      }
+    }
+    else {
+      // Number of batch for a source
+      GGsize number_of_batchs = source_manager.GetNumberOfBatchs(i, thread_index);
+
+      // Loop over batch
+      for (GGsize j = 0; j < number_of_batchs; ++j) {
+        RunBatch(i, thread_index, source_manager.GetNumberOfParticlesInBatch(i, thread_index, j));
+
+        // Incrementing progress bar
+        mutex.lock();
+        ++(*progress_bar_);
+        mutex.unlock();
+      }
+    }
+  }
+}
 
-    // Loop over batch
-    for (GGsize j = 0; j < number_of_batchs; ++j) {
-      GGsize number_of_particles = source_manager.GetNumberOfParticlesInBatch(i, thread_index, j);
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
-      // Generating particles
-      source_manager.GetPrimaries(i, thread_index, number_of_particles);
+void GGEMS::RunBatch(GGsize const& source_index, GGsize const& thread_index, GGsize const& number_of_particles)
+{
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
 
-      // Loop until ALL particles are dead
-      GGint loop_counter = 0, max_loop = 100; // Prevent infinite loop
-      do {
-        // Step 2: Find closest navigator (phantom, detector) before projection and track operation
-        navigator_manager.FindSolid(thread_index);
+  // Command queue is in-order, kernels are enqueued back to back and the host waits only when reading the alive status
+  cl::CommandQueue* queue = GGEMSOpenCLManager::GetInstance().GetCommandQueue(thread_index);
 
-        // Optional step: World tracking
-        navigator_manager.WorldTracking(thread_index);
+  // Generating particles
+  source_manager.GetPrimaries(source_index, thread_index, number_of_particles);
 
-        // Step 3: Project particles to solid
-        navigator_manager.ProjectToSolid(thread_index);
+  // Loop until ALL particles are dead
+  GGint loop_counter = 0, max_loop = 100; // Prevent infinite loop
+  do {
+    // Step 2: Find closest navigator (phantom, detector) before projection and track operation
+    navigator_manager.FindSolid(thread_index);
+    if (!is_asynchronous_stepping_) queue->finish();
 
-        // Step 4: Track through step, particles are tracked in selected solid
-        navigator_manager.TrackThroughSolid(thread_index);
+    // Optional step: World tracking
+    navigator_manager.WorldTracking(thread_index);
+    if (!is_asynchronous_stepping_) queue->finish();
 
-        loop_counter++;
-      } while (source_manager.IsAlive(thread_index) && loop_counter < max_loop); // Step 5: Checking if all particles are dead, otherwize go back to step 2
+    // Step 3: Project particles to solid
+    navigator_manager.ProjectToSolid(thread_index);
+    if (!is_asynchronous_stepping_) queue->finish();
 
-      // Incrementing progress bar
-      mutex.lock();
-      ++progress_bar;
-      mutex.unlock();
+    // Step 4: Track through step, particles are tracked in selected solid
+    navigator_manager.TrackThroughSolid(thread_index);
+    if (!is_asynchronous_stepping_) queue->finish();
+    else queue->flush(); // Submitting the step to device while the alive kernel is enqueued
 
-      // If OpenGL, send particle OpenGL infos from OpenCL buffer to OpenGL for the current source
-      #ifdef OPENGL_VISUALIZATION
-      if (opengl_manager.IsOpenGLActivated()) {
-        opengl_manager.CopyParticlePositionToOpenGL(i);
-      }
-      #endif
-    }
-  }
+    loop_counter++;
+  } while (source_manager.IsAlive(thread_index) && loop_counter < max_loop); // Step 5: Checking if all particles are dead, otherwize go back to step 2
+
+  // Adding tallies of the batch to running sums (batch uncertainty)
+  navigator_manager.AccumulateBatch(thread_index);
 
-  // Computing dose
-  navigator_manager.ComputeDose(thread_index);
+  // If OpenGL, send particle OpenGL infos from OpenCL buffer to OpenGL for the current source
+  #ifdef OPENGL_VISUALIZATION
+  GGEMSOpenGLManager& opengl_manager = GGEMSOpenGLManager::GetInstance();
+  if (opengl_manager.IsOpenGLActivated()) {
+    opengl_manager.CopyParticlePositionToOpenGL(source_index);
+  }
+  #endif
 }
 
-////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMS::Run()
+void GGEMS::RunOnAllDevices(void)
 {
-  GGcout("GGEMS", "Run", 0) << "GGEMS simulation started" << GGendl;
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
 
-  ChronoTime start_time = GGEMSChrono::Now();
+  // Printing progress bar
+  progress_bar_ = new GGEMSProgressBar(is_dynamic_load_balancing_ ? source_manager.GetTotalNumberOfSharedBatchs() : source_manager.GetTotalNumberOfBatchs());
 
   // Creating a thread for each OpenCL device
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
@@ -378,9 +533,53 @@ void GGEMS::Run()
   // Deleting threads
   delete[] thread_device;
 
+  delete progress_bar_;
+  progress_bar_ = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::PrepareRun(void)
+{
+  // Nothing to do for first run after initialization
+  if (number_of_runs_ == 0) return;
+
+  // Taking into account source parameters modified since previous run, physics tables and kernels are kept
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  source_manager.Update();
+
+  // Cleaning tallies of previous run
+  if (!is_tally_accumulation_) {
+    GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+    navigator_manager.ResetTallies();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMS::Run(GGuint const& seed)
+{
+  GGcout("GGEMS", "Run", 0) << "GGEMS simulation started" << GGendl;
+
+  ChronoTime start_time = GGEMSChrono::Now();
+
+  PrepareRun();
+
+  // Random streams restart from a new seed (seed sweep), otherwise they continue from previous run
+  if (seed != 0) GGEMSSourceManager::GetInstance().GetPseudoRandomGenerator()->SetSeed(seed);
+
+  RunOnAllDevices();
+
+  // Summing tallies of all devices and computing dose once
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+  navigator_manager.ComputeDose();
+
   // End of simulation, storing output
   GGcout("GGEMS", "Run", 1) << "Saving results..." << GGendl;
-  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
   navigator_manager.SaveResults();
 
   // Printing elapsed time in kernels
@@ -391,6 +590,8 @@ void GGEMS::Run()
 
   ChronoTime end_time = GGEMSChrono::Now();
 
+  ++number_of_runs_;
+
   GGcout("GGEMS", "Run", 0) << "GGEMS simulation succeeded" << GGendl;
 
   GGEMSChrono::DisplayTime(end_time - start_time, "GGEMS simulation");
@@ -409,6 +610,67 @@ void GGEMS::Run()
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMS::RunGantrySweep(GGsize const& number_of_projections, GGfloat const& angle_step, std::string const& unit)
+{
+  if (number_of_projections == 0) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Number of projections has to be > 0!!!";
+    GGEMSMisc::ThrowException("GGEMS", "RunGantrySweep", oss.str());
+  }
+
+  GGcout("GGEMS", "RunGantrySweep", 0) << "GGEMS simulation started" << GGendl;
+
+  ChronoTime start_time = GGEMSChrono::Now();
+
+  PrepareRun();
+
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+
+  GGfloat angle = AngleUnit(angle_step, unit);
+
+  for (GGsize p = 0; p < number_of_projections; ++p) {
+    // Rotating sources and detectors from previous projection, kernels and data already on device are kept
+    if (p > 0) {
+      source_manager.RotateGantry(angle);
+      navigator_manager.RotateGantry(angle);
+      navigator_manager.ResetProjection();
+      source_manager.ResetSharedBatchs();
+    }
+
+    GGcout("GGEMS", "RunGantrySweep", 1) << "Projection " << p+1 << "/" << number_of_projections << GGendl;
+
+    RunOnAllDevices();
+
+    navigator_manager.SaveProjection(p);
+  }
+
+  // Dose of whole sweep, tallies of all devices are summed once
+  navigator_manager.ComputeDose();
+
+  // End of simulation, storing dosimetry and world output, detector output is saved projection by projection
+  GGcout("GGEMS", "RunGantrySweep", 1) << "Saving results..." << GGendl;
+  navigator_manager.SaveSweepResults();
+
+  // Printing elapsed time in kernels
+  if (is_profiling_verbose_) {
+    GGEMSProfilerManager& profiler_manager = GGEMSProfilerManager::GetInstance();
+    profiler_manager.PrintSummaryProfile();
+  }
+
+  ChronoTime end_time = GGEMSChrono::Now();
+
+  ++number_of_runs_;
+
+  GGcout("GGEMS", "RunGantrySweep", 0) << "GGEMS simulation succeeded" << GGendl;
+
+  GGEMSChrono::DisplayTime(end_time - start_time, "GGEMS simulation");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMS::PrintBanner(void) const
 {
   std::cout << std::endl;
@@ -548,7 +810,70 @@ void set_tracking_ggems(GGEMS* ggems, bool const is_tracking_verbose, GGint cons
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void run_ggems(GGEMS* ggems)
+void run_ggems(GGEMS* ggems, GGuint const seed)
+{
+  ggems->Run(seed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void run_gantry_sweep_ggems(GGEMS* ggems, GGsize const number_of_projections, GGfloat const angle_step, char const* unit)
+{
+  ggems->RunGantrySweep(number_of_projections, angle_step, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_asynchronous_stepping_ggems(GGEMS* ggems, bool const is_asynchronous_stepping)
+{
+  ggems->SetAsynchronousStepping(is_asynchronous_stepping);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_particle_compaction_ggems(GGEMS* ggems, bool const is_particle_compaction)
+{
+  ggems->SetParticleCompaction(is_particle_compaction);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_random_engine_ggems(GGEMS* ggems, char const* random_engine)
+{
+  ggems->SetRandomEngine(random_engine);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_dynamic_load_balancing_ggems(GGEMS* ggems, bool const is_dynamic_load_balancing)
+{
+  ggems->SetDynamicLoadBalancing(is_dynamic_load_balancing);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_tally_accumulation_ggems(GGEMS* ggems, bool const is_tally_accumulation)
+{
+  ggems->SetTallyAccumulation(is_tally_accumulation);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_particle_batch_size_ggems(GGEMS* ggems, GGsize const particle_batch_size)
 {
-  ggems->Run();
+  ggems->SetParticleBatchSize(particle_batch_size);
 }
@@ -30,6 +30,10 @@
 
 #include <algorithm>
 #include <sstream>
+#include <filesystem>
+#include <random>
+#include <cstdlib>
+#include <limits>
 
 #include "GGEMS/tools/GGEMSTools.hh"
 #include "GGEMS/global/GGEMSOpenCLManager.hh"
@@ -40,6 +44,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 GGEMSOpenCLManager::GGEMSOpenCLManager(void)
+: kernel_cache_directory_(""),
+  is_work_group_tuning_(false)
 {
   GGcout("GGEMSOpenCLManager", "GGEMSOpenCLManager", 3) << "GGEMSOpenCLManager creating..." << GGendl;
 
@@ -83,6 +89,9 @@ void GGEMSOpenCLManager::Clean(void)
     k = nullptr;
   }
   kernels_.clear();
+  kernel_compilation_options_.clear();
+  kernel_particle_capacities_.clear();
+  kernel_work_group_sizes_.clear();
 
   GGcout("GGEMSOpenCLManager", "Clean", 3) << "GGEMSOpenCLManager cleaned!!!" << GGendl;
 }
@@ -101,6 +110,13 @@ void GGEMSOpenCLManager::InitOpenCL(void)
   GetOpenCLDevices();
   SetOpenCLCompilationOptions();
 
+  // Directory of kernel binary cache, GGEMS_KERNEL_CACHE_PATH environment variable overrides CMake value
+  #ifdef OPENCL_KERNEL_CACHE_PATH
+  kernel_cache_directory_ = OPENCL_KERNEL_CACHE_PATH;
+  #endif
+  char const* kernel_cache_path = std::getenv("GGEMS_KERNEL_CACHE_PATH");
+  if (kernel_cache_path) kernel_cache_directory_ = kernel_cache_path;
+
   // Filling alias vendor
   vendors_.insert(std::make_pair("nvidia", "NVIDIA Corporation"));
   vendors_.insert(std::make_pair("intel", "Intel(R) Corporation"));
@@ -397,6 +413,9 @@ void GGEMSOpenCLManager::GetOpenCLDevices(void)
 
   // Custom work group size, 64 seems a good trade-off
   work_group_size_ = 64;
+
+  // Capacity of particle buffers by default, can be changed before compiling kernels
+  particle_capacity_ = MAXIMUM_PARTICLES;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -553,6 +572,7 @@ void GGEMSOpenCLManager::PrintDeviceInfos(void) const
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + Partition Affinity: " << partition_affinity << GGendl;
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + Timer Resolution: " << device_profiling_timer_resolution_[i] << " ns" << GGendl;
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + GGEMS Custom Work Group Size: " << work_group_size_ << GGendl;
+    GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + GGEMS Particle Buffer Capacity: " << particle_capacity_ << GGendl;
   }
   GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << GGendl;
 }
@@ -592,6 +612,13 @@ void GGEMSOpenCLManager::PrintBuildOptions(void) const
   #else
   GGcout("GGEMSOpenCLManager", "PrintBuildOptions", 0) << "OpenCL NVIDIA kernel cache compilation: ON" << GGendl;
   #endif
+  if (kernel_cache_directory_.empty()) {
+    GGcout("GGEMSOpenCLManager", "PrintBuildOptions", 0) << "OpenCL kernel binary cache: OFF" << GGendl;
+  }
+  else {
+    GGcout("GGEMSOpenCLManager", "PrintBuildOptions", 0) << "OpenCL kernel binary cache: " << kernel_cache_directory_ << GGendl;
+  }
+  GGcout("GGEMSOpenCLManager", "PrintBuildOptions", 0) << "OpenCL work group size tuning: " << (is_work_group_tuning_ ? "ON" : "OFF") << GGendl;
   GGcout("GGEMSOpenCLManager", "PrintBuildOptions", 0) << "OpenCL building options: " << build_options_ << GGendl;
 }
 
@@ -635,6 +662,43 @@ void GGEMSOpenCLManager::AddBuildOption(std::string const& option)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSOpenCLManager::SetParticleCapacity(GGsize const& particle_capacity)
+{
+  if (particle_capacity == 0) {
+    GGEMSMisc::ThrowException("GGEMSOpenCLManager", "SetParticleCapacity", "Capacity of particle buffers has to be > 0!!!");
+  }
+
+  // Capacity is a multiple of work group size, so arrays of particle and random structures are aligned in the same way on host and device
+  GGsize new_particle_capacity = GetBestWorkItem(particle_capacity);
+
+  // Kernels using particle buffers are compiled with the capacity, it can not change after, other kernels (drawing solids for instance) are not concerned
+  for (GGsize i = 0; i < kernel_particle_capacities_.size(); ++i) {
+    if (kernel_particle_capacities_[i] != 0 && kernel_particle_capacities_[i] != new_particle_capacity) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Capacity of particle buffers has to be set before compiling kernels using particles, kernel compiled with " << kernel_particle_capacities_[i] << " particles!!!";
+      GGEMSMisc::ThrowException("GGEMSOpenCLManager", "SetParticleCapacity", oss.str());
+    }
+  }
+
+  particle_capacity_ = new_particle_capacity;
+
+  // Removing previous capacity from building options
+  std::string::size_type option_position = build_options_.find(" -DMAXIMUM_PARTICLES=");
+  if (option_position != std::string::npos) {
+    std::string::size_type option_end = build_options_.find(' ', option_position+1);
+    build_options_.erase(option_position, option_end == std::string::npos ? std::string::npos : option_end-option_position);
+  }
+
+  // Arrays in particle and random structures are sized by MAXIMUM_PARTICLES in kernels
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "-DMAXIMUM_PARTICLES=" << particle_capacity_;
+  AddBuildOption(oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSOpenCLManager::DeviceToActivate(std::string const& device_type, std::string const& device_vendor)
 {
   // Transform all parameters in lower caracters
@@ -875,26 +939,53 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
     // Creating an OpenCL program
     cl::Program::Sources program_source(1, std::make_pair(source_code.c_str(), source_code.length() + 1));
 
+    // Kernel and included headers are read, to key the kernel binary cache and to find if particle buffers are used
+    std::string kernel_sources("");
+    std::vector<std::string> read_files;
+    ReadKernelSources(kernel_filename, kernel_sources, read_files);
+
+    // Arrays of particle and random structures are sized with the capacity of particle buffers
+    GGsize kernel_particle_capacity = kernel_sources.find("[MAXIMUM_PARTICLES]") != std::string::npos ? particle_capacity_ : 0;
+
     // Loop over activated device
     for (GGsize i = 0; i < computing_devices_.size(); ++i) {
-      // Make program from source code in context
-      cl::Program program = cl::Program(*computing_devices_[i].context_, program_source);
-
-      // Get device associated to context, in our case 1 context = 1 device
-      std::vector<cl::Device> device;
-      CheckOpenCLError(computing_devices_[i].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "CompileKernel");
-
-      GGcout("GGEMSOpenCLManager", "CompileKernel", 2) << "Compile a new kernel '" << kernel_name << "' from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << kernel_compilation_option << GGendl;
-
-      // Compile source code on device
-      GGint build_status = program.build(device, kernel_compilation_option);
-      if (build_status != CL_SUCCESS) {
-        std::ostringstream oss(std::ostringstream::out);
-        std::string log;
-        program.getBuildInfo(device[0], CL_PROGRAM_BUILD_LOG, &log);
-        oss << ErrorType(build_status) << std::endl;
-        oss << log;
-        GGEMSMisc::ThrowException("GGEMSOpenCLManager", "CompileKernel", oss.str());
+      cl::Program program;
+      GGint build_status = CL_SUCCESS;
+
+      // Trying to load program from kernel cache
+      std::string cache_filename("");
+      bool is_cached = false;
+      if (!kernel_cache_directory_.empty()) {
+        cache_filename = GetKernelCacheFilename(kernel_name, kernel_sources, kernel_compilation_option, i);
+        is_cached = LoadKernelBinary(cache_filename, kernel_compilation_option, i, program);
+      }
+
+      if (is_cached) {
+        GGcout("GGEMSOpenCLManager", "CompileKernel", 2) << "Load kernel '" << kernel_name << "' from cache: " << cache_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << GGendl;
+      }
+      else {
+        // Make program from source code in context
+        program = cl::Program(*computing_devices_[i].context_, program_source);
+
+        // Get device associated to context, in our case 1 context = 1 device
+        std::vector<cl::Device> device;
+        CheckOpenCLError(computing_devices_[i].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "CompileKernel");
+
+        GGcout("GGEMSOpenCLManager", "CompileKernel", 2) << "Compile a new kernel '" << kernel_name << "' from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << kernel_compilation_option << GGendl;
+
+        // Compile source code on device
+        build_status = program.build(device, kernel_compilation_option);
+        if (build_status != CL_SUCCESS) {
+          std::ostringstream oss(std::ostringstream::out);
+          std::string log;
+          program.getBuildInfo(device[0], CL_PROGRAM_BUILD_LOG, &log);
+          oss << ErrorType(build_status) << std::endl;
+          oss << log;
+          GGEMSMisc::ThrowException("GGEMSOpenCLManager", "CompileKernel", oss.str());
+        }
+
+        // Storing program binary for next runs
+        if (!cache_filename.empty()) SaveKernelBinary(cache_filename, program);
       }
 
       // Storing the kernel in the singleton
@@ -902,8 +993,12 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
       kernel_list[i] = kernels_.back();
       CheckOpenCLError(build_status, "GGEMSOpenCLManager", "CompileKernel");
 
+      // Work group size of kernel, tuned size is stored next to program binary
+      InitializeKernelWorkGroupSize(kernels_.back(), i, cache_filename);
+
       // Storing the compilation options
       kernel_compilation_options_.push_back(kernel_compilation_option);
+      kernel_particle_capacities_.push_back(kernel_particle_capacity);
     }
   }
 }
@@ -912,6 +1007,153 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSOpenCLManager::SetKernelCacheDirectory(std::string const& directory)
+{
+  kernel_cache_directory_ = directory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::ReadKernelSources(std::string const& filename, std::string& sources, std::vector<std::string>& read_files) const
+{
+  // Each file is read only once
+  if (std::find(read_files.begin(), read_files.end(), filename) != read_files.end()) return;
+  read_files.push_back(filename);
+
+  std::ifstream file_stream(filename.c_str(), std::ios::in);
+  if (!file_stream) return;
+
+  std::string line("");
+  while (std::getline(file_stream, line)) {
+    sources += line;
+    sources += "\n";
+
+    // Looking for included header
+    std::size_t include_position = line.find("#include");
+    if (include_position == std::string::npos) continue;
+
+    std::size_t first = line.find_first_of("\"<", include_position);
+    if (first == std::string::npos) continue;
+    std::size_t last = line.find_first_of("\">", first+1);
+    if (last == std::string::npos) continue;
+
+    std::string header = line.substr(first+1, last-first-1);
+
+    // Header is searched in GGEMS include directory, then in the directory of the current file
+    std::string header_filename("");
+    #ifdef GGEMS_PATH
+    header_filename = std::string(GGEMS_PATH) + "/include/" + header;
+    #endif
+    if (!std::filesystem::exists(header_filename)) {
+      header_filename = (std::filesystem::path(filename).parent_path() / header).string();
+    }
+
+    // System headers are not found and not hashed
+    if (std::filesystem::exists(header_filename)) ReadKernelSources(header_filename, sources, read_files);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GGEMSOpenCLManager::GetKernelCacheFilename(std::string const& kernel_name, std::string const& sources, std::string const& compilation_options, GGsize const& thread_index) const
+{
+  GGsize device_index = computing_devices_[thread_index].index_;
+
+  // Key storing everything changing the program binary
+  std::string key = sources;
+  key += "\n" + compilation_options;
+  key += "\n" + device_name_[device_index];
+  key += "\n" + device_vendor_[device_index];
+  key += "\n" + device_version_[device_index];
+  key += "\n" + device_driver_version_[device_index];
+
+  std::ostringstream oss(std::ostringstream::out);
+  oss << kernel_name << "_" << GGEMSMisc::HashContent(key) << ".bin";
+
+  return (std::filesystem::path(kernel_cache_directory_) / oss.str()).string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSOpenCLManager::LoadKernelBinary(std::string const& filename, std::string const& compilation_options, GGsize const& thread_index, cl::Program& program)
+{
+  std::ifstream binary_stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!binary_stream) return false;
+
+  std::vector<GGuchar> binary((std::istreambuf_iterator<char>(binary_stream)), std::istreambuf_iterator<char>());
+  if (binary.empty()) return false;
+
+  // Get device associated to context, in our case 1 context = 1 device
+  std::vector<cl::Device> device;
+  CheckOpenCLError(computing_devices_[thread_index].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "LoadKernelBinary");
+
+  // Make program from binary, a rejected binary (driver update for instance) is compiled again from source
+  cl::Program::Binaries program_binary(1, std::make_pair(static_cast<void const*>(binary.data()), binary.size()));
+  std::vector<cl_int> binary_status;
+  GGint error = CL_SUCCESS;
+  cl::Program binary_program(*computing_devices_[thread_index].context_, device, program_binary, &binary_status, &error);
+  if (error != CL_SUCCESS || binary_status.empty() || binary_status[0] != CL_SUCCESS) {
+    GGwarn("GGEMSOpenCLManager", "LoadKernelBinary", 1) << "Kernel binary '" << filename << "' rejected by OpenCL device, kernel is compiled from source" << GGendl;
+    return false;
+  }
+
+  if (binary_program.build(device, compilation_options.c_str()) != CL_SUCCESS) {
+    GGwarn("GGEMSOpenCLManager", "LoadKernelBinary", 1) << "Kernel binary '" << filename << "' can not be built, kernel is compiled from source" << GGendl;
+    return false;
+  }
+
+  program = binary_program;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::SaveKernelBinary(std::string const& filename, cl::Program& program) const
+{
+  // In our case 1 program = 1 device, so only one binary
+  GGsize binary_size = 0;
+  if (clGetProgramInfo(program(), CL_PROGRAM_BINARY_SIZES, sizeof(GGsize), &binary_size, nullptr) != CL_SUCCESS || binary_size == 0) {
+    GGwarn("GGEMSOpenCLManager", "SaveKernelBinary", 1) << "No binary available for kernel cache: " << filename << GGendl;
+    return;
+  }
+
+  std::vector<GGuchar> binary(binary_size);
+  GGuchar* binary_ptr = binary.data();
+  if (clGetProgramInfo(program(), CL_PROGRAM_BINARIES, sizeof(GGuchar*), &binary_ptr, nullptr) != CL_SUCCESS) {
+    GGwarn("GGEMSOpenCLManager", "SaveKernelBinary", 1) << "Impossible to get binary for kernel cache: " << filename << GGendl;
+    return;
+  }
+
+  // Creating cache directory if necessary
+  std::error_code error_code;
+  std::filesystem::create_directories(kernel_cache_directory_, error_code);
+
+  // Writing in a temporary file then renaming it, several GGEMS processes could share the same cache
+  std::string tmp_filename = filename + ".tmp" + std::to_string(std::random_device{}());
+  std::ofstream binary_stream(tmp_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!binary_stream) {
+    GGwarn("GGEMSOpenCLManager", "SaveKernelBinary", 1) << "Impossible to write in kernel cache directory: " << kernel_cache_directory_ << GGendl;
+    return;
+  }
+  binary_stream.write(reinterpret_cast<char*>(binary.data()), static_cast<std::streamsize>(binary_size));
+  binary_stream.close();
+
+  std::filesystem::rename(tmp_filename, filename, error_code);
+  if (error_code) std::filesystem::remove(tmp_filename, error_code);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 cl::Buffer* GGEMSOpenCLManager::Allocate(void* host_ptr, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags, std::string const& class_name)
 {
   GGcout("GGEMSOpenCLManager","Allocate", 3) << "Allocating memory on OpenCL device memory..." << GGendl;
@@ -1007,14 +1249,23 @@ bool GGEMSOpenCLManager::IsDoublePrecisionAtomicAddition(GGsize const& device_in
 
 GGsize GGEMSOpenCLManager::GetBestWorkItem(GGsize const& number_of_elements) const
 {
-  if (number_of_elements%work_group_size_ == 0) {
+  return GetBestWorkItem(number_of_elements, work_group_size_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSOpenCLManager::GetBestWorkItem(GGsize const& number_of_elements, GGsize const& work_group_size) const
+{
+  if (number_of_elements%work_group_size == 0) {
     return number_of_elements;
   }
-  else if (number_of_elements <= work_group_size_) {
-    return work_group_size_;
+  else if (number_of_elements <= work_group_size) {
+    return work_group_size;
   }
   else {
-    return number_of_elements + (work_group_size_ - number_of_elements%work_group_size_);
+    return number_of_elements + (work_group_size - number_of_elements%work_group_size);
   }
 }
 
@@ -1022,6 +1273,139 @@ GGsize GGEMSOpenCLManager::GetBestWorkItem(GGsize const& number_of_elements) con
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSOpenCLManager::SetWorkGroupTuning(bool const& is_work_group_tuning)
+{
+  is_work_group_tuning_ = is_work_group_tuning;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSOpenCLManager::GetKernelWorkGroupSize(cl::Kernel* kernel) const
+{
+  KernelWorkGroupSizeUMap::const_iterator iter = kernel_work_group_sizes_.find(kernel);
+  if (iter == kernel_work_group_sizes_.end()) return work_group_size_;
+
+  KernelWorkGroupSize const& kernel_work_group_size = iter->second;
+  if (kernel_work_group_size.is_tuned_ || !is_work_group_tuning_) return kernel_work_group_size.work_group_size_;
+
+  // Candidates are timed one after the other
+  return kernel_work_group_size.candidates_[kernel_work_group_size.number_of_timings_/WORK_GROUP_TUNING_LAUNCHES];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::TuneKernelWorkGroupSize(cl::Kernel* kernel, cl::Event& event, GGsize const& number_of_work_items)
+{
+  if (!is_work_group_tuning_ || number_of_work_items < WORK_GROUP_TUNING_MIN_WORK_ITEMS) return;
+
+  // Each kernel is launched by only one device thread, so each entry is modified by only one thread
+  KernelWorkGroupSizeUMap::iterator iter = kernel_work_group_sizes_.find(kernel);
+  if (iter == kernel_work_group_sizes_.end() || iter->second.is_tuned_) return;
+
+  KernelWorkGroupSize& kernel_work_group_size = iter->second;
+
+  // Waiting for the kernel, only during tuning
+  CheckOpenCLError(event.wait(), "GGEMSOpenCLManager", "TuneKernelWorkGroupSize");
+
+  GGulong start_time = 0, end_time = 0;
+  CheckOpenCLError(event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start_time), "GGEMSOpenCLManager", "TuneKernelWorkGroupSize");
+  CheckOpenCLError(event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end_time), "GGEMSOpenCLManager", "TuneKernelWorkGroupSize");
+
+  // Number of particles changes between launches, so time is compared by work-item
+  GGdouble time_by_work_item = static_cast<GGdouble>(end_time - start_time) / static_cast<GGdouble>(number_of_work_items);
+  GGsize candidate_index = kernel_work_group_size.number_of_timings_/WORK_GROUP_TUNING_LAUNCHES;
+  if (time_by_work_item < kernel_work_group_size.timings_[candidate_index]) kernel_work_group_size.timings_[candidate_index] = time_by_work_item;
+
+  ++kernel_work_group_size.number_of_timings_;
+  if (kernel_work_group_size.number_of_timings_ < kernel_work_group_size.candidates_.size()*WORK_GROUP_TUNING_LAUNCHES) return;
+
+  // Keeping the fastest candidate
+  GGsize best_index = static_cast<GGsize>(std::min_element(kernel_work_group_size.timings_.begin(), kernel_work_group_size.timings_.end()) - kernel_work_group_size.timings_.begin());
+  kernel_work_group_size.work_group_size_ = kernel_work_group_size.candidates_[best_index];
+  kernel_work_group_size.is_tuned_ = true;
+
+  std::string kernel_name;
+  CheckOpenCLError(kernel->getInfo(CL_KERNEL_FUNCTION_NAME, &kernel_name), "GGEMSOpenCLManager", "TuneKernelWorkGroupSize");
+  GGcout("GGEMSOpenCLManager", "TuneKernelWorkGroupSize", 1) << "Work group size of kernel '" << kernel_name << "' tuned to " << kernel_work_group_size.work_group_size_ << GGendl;
+
+  if (!kernel_work_group_size.cache_filename_.empty()) SaveKernelWorkGroupSize(kernel_work_group_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::InitializeKernelWorkGroupSize(cl::Kernel* kernel, GGsize const& thread_index, std::string const& cache_filename)
+{
+  // Get device associated to context, in our case 1 context = 1 device
+  std::vector<cl::Device> device;
+  CheckOpenCLError(computing_devices_[thread_index].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "InitializeKernelWorkGroupSize");
+
+  GGsize kernel_max_work_group_size = 0, preferred_multiple = 0;
+  CheckOpenCLError(kernel->getWorkGroupInfo(device[0], CL_KERNEL_WORK_GROUP_SIZE, &kernel_max_work_group_size), "GGEMSOpenCLManager", "InitializeKernelWorkGroupSize");
+  CheckOpenCLError(kernel->getWorkGroupInfo(device[0], CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE, &preferred_multiple), "GGEMSOpenCLManager", "InitializeKernelWorkGroupSize");
+
+  KernelWorkGroupSize kernel_work_group_size;
+  kernel_work_group_size.work_group_size_ = work_group_size_ <= kernel_max_work_group_size ? work_group_size_ : kernel_max_work_group_size;
+  kernel_work_group_size.is_tuned_ = false;
+  kernel_work_group_size.number_of_timings_ = 0;
+  kernel_work_group_size.cache_filename_ = cache_filename.empty() ? "" : std::filesystem::path(cache_filename).replace_extension(".wgs").string();
+
+  // Candidates are preferred multiple times powers of 2 within kernel limit
+  if (preferred_multiple == 0) preferred_multiple = 1;
+  for (GGsize candidate = preferred_multiple; candidate <= kernel_max_work_group_size && candidate <= WORK_GROUP_TUNING_MAX_SIZE; candidate *= 2) {
+    if (candidate >= WORK_GROUP_TUNING_MIN_SIZE) kernel_work_group_size.candidates_.push_back(candidate);
+  }
+  kernel_work_group_size.timings_.assign(kernel_work_group_size.candidates_.size(), std::numeric_limits<GGdouble>::max());
+
+  // Nothing to tune if only one candidate
+  if (kernel_work_group_size.candidates_.size() <= 1) {
+    kernel_work_group_size.work_group_size_ = kernel_work_group_size.candidates_.empty() ? kernel_work_group_size.work_group_size_ : kernel_work_group_size.candidates_[0];
+    kernel_work_group_size.is_tuned_ = true;
+  }
+
+  // Size tuned by a previous run
+  if (!kernel_work_group_size.cache_filename_.empty()) {
+    std::ifstream tuning_stream(kernel_work_group_size.cache_filename_.c_str(), std::ios::in);
+    GGsize tuned_work_group_size = 0;
+    if (tuning_stream >> tuned_work_group_size && tuned_work_group_size > 0 && tuned_work_group_size <= kernel_max_work_group_size) {
+      kernel_work_group_size.work_group_size_ = tuned_work_group_size;
+      kernel_work_group_size.is_tuned_ = true;
+    }
+  }
+
+  kernel_work_group_sizes_[kernel] = kernel_work_group_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::SaveKernelWorkGroupSize(KernelWorkGroupSize const& kernel_work_group_size) const
+{
+  // Writing in a temporary file then renaming it, several GGEMS processes could share the same cache
+  std::string tmp_filename = kernel_work_group_size.cache_filename_ + ".tmp" + std::to_string(std::random_device{}());
+  std::ofstream tuning_stream(tmp_filename.c_str(), std::ios::out);
+  if (!tuning_stream) {
+    GGwarn("GGEMSOpenCLManager", "SaveKernelWorkGroupSize", 1) << "Impossible to write in kernel cache directory: " << kernel_cache_directory_ << GGendl;
+    return;
+  }
+  tuning_stream << kernel_work_group_size.work_group_size_ << std::endl;
+  tuning_stream.close();
+
+  std::error_code error_code;
+  std::filesystem::rename(tmp_filename, kernel_work_group_size.cache_filename_, error_code);
+  if (error_code) std::filesystem::remove(tmp_filename, error_code);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSOpenCLManager::HandleEvent(cl::Event& event, char* message)
 {
   clRetainEvent(event());
@@ -1552,3 +1936,21 @@ void set_device_balancing_opencl_manager(GGEMSOpenCLManager* opencl_manager, cha
 {
   opencl_manager->DeviceBalancing(device_balancing);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_kernel_cache_directory_opencl_manager(GGEMSOpenCLManager* opencl_manager, char const* directory)
+{
+  opencl_manager->SetKernelCacheDirectory(directory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_work_group_tuning_opencl_manager(GGEMSOpenCLManager* opencl_manager, bool const is_work_group_tuning)
+{
+  opencl_manager->SetWorkGroupTuning(is_work_group_tuning);
+}
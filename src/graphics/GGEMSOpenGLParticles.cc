@@ -30,6 +30,8 @@
 
 #ifdef OPENGL_VISUALIZATION
 
+#include <cstddef>
+
 #include "GGEMS/graphics/GGEMSOpenGLParticles.hh"
 #include "GGEMS/sources/GGEMSSourceManager.hh"
 #include "GGEMS/graphics/GGEMSOpenGLManager.hh"
@@ -175,9 +177,9 @@ void GGEMSOpenGLParticles::CopyParticlePosition(void)
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
   GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
 
-  // Getting primary particles from OpenCL
+  // Getting primary particles from OpenCL, interactions are stored before particle arrays
   cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(0);
-  GGEMSPrimaryParticles* primary_particles_device = opencl_manager.GetDeviceBuffer<GGEMSPrimaryParticles>(primary_particles, CL_TRUE, CL_MAP_READ, sizeof(GGEMSPrimaryParticles), 0);
+  GGEMSPrimaryParticles* primary_particles_device = opencl_manager.GetDeviceBuffer<GGEMSPrimaryParticles>(primary_particles, CL_TRUE, CL_MAP_READ, offsetof(GGEMSPrimaryParticles, E_), 0);
 
   // Loop over particles
   for (GGsize i = 0; i < number_of_particles_; ++i) {
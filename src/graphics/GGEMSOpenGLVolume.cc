@@ -255,7 +255,7 @@ void GGEMSOpenGLVolume::SetMaterial(std::string const& material_name)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSOpenGLVolume::SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels)
+void GGEMSOpenGLVolume::SetMaterial(GGEMSMaterials const* materials, cl::Buffer* label, GGsize const& number_of_voxels, GGsize const& label_size)
 {
   // Cleaning previous color and material
   material_rgb_.clear();
@@ -270,17 +270,20 @@ void GGEMSOpenGLVolume::SetMaterial(GGEMSMaterials const* materials, cl::Buffer*
   }
 
   // Storing label from OpenCL
-  label_ = new GGuchar[number_of_voxels];
+  label_ = new GGushort[number_of_voxels];
 
-  // Get pointer on OpenCL device
+  // Get pointer on OpenCL device, labels are stored on 8 or 16 bits
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  GGuchar* label_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels * sizeof(GGuchar), 0);
-
-  // Copy data
-  for (GGsize i = 0; i < number_of_voxels; ++i) label_[i] = label_data_device[i];
-
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(label, label_data_device, 0);
+  if (label_size == sizeof(GGushort)) {
+    GGushort* label_data_device = opencl_manager.GetDeviceBuffer<GGushort>(label, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels * sizeof(GGushort), 0);
+    for (GGsize i = 0; i < number_of_voxels; ++i) label_[i] = label_data_device[i];
+    opencl_manager.ReleaseDeviceBuffer(label, label_data_device, 0);
+  }
+  else {
+    GGuchar* label_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels * sizeof(GGuchar), 0);
+    for (GGsize i = 0; i < number_of_voxels; ++i) label_[i] = label_data_device[i];
+    opencl_manager.ReleaseDeviceBuffer(label, label_data_device, 0);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
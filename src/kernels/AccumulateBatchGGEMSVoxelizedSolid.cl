@@ -0,0 +1,62 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file AccumulateBatchGGEMSVoxelizedSolid.cl
+
+  \brief OpenCL kernel adding energy deposit of a batch to running sums in voxelized solid
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include "GGEMS/tools/GGEMSTypes.hh"
+
+/*!
+  \fn kernel void accumulate_batch_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGDosiTallyType* edep_batch, global GGDosiTallyType* edep, global GGDosiTallyType* edep_squared)
+  \param dosel_id_limit - number total of dosels
+  \param edep_batch - energy deposit of current batch, reset to zero
+  \param edep - sum of energy deposit of batches
+  \param edep_squared - sum of squared energy deposit of batches
+  \brief adding energy deposit of a batch and its square to running sums, one work-item by dosel so no atomic is needed
+*/
+kernel void accumulate_batch_ggems_voxelized_solid(
+  GGsize const dosel_id_limit,
+  global GGDosiTallyType* edep_batch,
+  global GGDosiTallyType* edep,
+  global GGDosiTallyType* edep_squared
+)
+{
+  // Getting index of thread
+  GGint global_id = get_global_id(0);
+
+  // Return if index > to dosel limit
+  if (global_id >= dosel_id_limit) return;
+
+  GGDosiTallyType batch_tally = edep_batch[global_id];
+  if (batch_tally == 0) return;
+
+  GGDosiType batch_edep = ConvertTallyToDose(batch_tally);
+
+  edep[global_id] += batch_tally;
+  edep_squared[global_id] += ConvertSquaredDoseToTally(batch_edep*batch_edep);
+  edep_batch[global_id] = 0;
+}
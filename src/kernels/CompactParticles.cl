@@ -0,0 +1,163 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file CompactParticles.cl
+
+  \brief OpenCL kernels packing alive particles at the beginning of the particle buffer
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSParticleConstants.hh"
+
+/*!
+  \fn inline GGint LocalInclusiveScan(local GGint* scan, GGint const value)
+  \param scan - local buffer of work-group size
+  \param value - value of the work-item
+  \return sum of the values of the work-items before and including the current one
+  \brief inclusive prefix sum inside a work-group, all the work-items of the group must call it
+*/
+inline GGint LocalInclusiveScan(local GGint* scan, GGint const value)
+{
+  GGsize local_id = get_local_id(0);
+  GGsize local_size = get_local_size(0);
+
+  scan[local_id] = value;
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  for (GGsize offset = 1; offset < local_size; offset <<= 1) {
+    GGint previous = (local_id >= offset) ? scan[local_id - offset] : 0;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    scan[local_id] += previous;
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+
+  return scan[local_id];
+}
+
+/*!
+  \fn kernel void count_alive_particles(GGsize const particle_id_limit, global GGEMSPrimaryParticles const* primary_particle, global GGint* group_alive, local GGint* scan)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer on primary particles
+  \param group_alive - number of alive particles in each work-group
+  \param scan - local buffer of work-group size
+  \brief count the alive particles of each work-group
+*/
+kernel void count_alive_particles(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles const* primary_particle,
+  global GGint* group_alive,
+  local GGint* scan
+)
+{
+  // Get the index of thread, no early return, all work-items take part in the scan
+  GGsize global_id = get_global_id(0);
+
+  GGint is_alive = (global_id < particle_id_limit && primary_particle->status_[global_id] == ALIVE) ? 1 : 0;
+  GGint alive = LocalInclusiveScan(scan, is_alive);
+
+  // Last work-item stores the total of the work-group
+  if (get_local_id(0) == get_local_size(0) - 1) group_alive[get_group_id(0)] = alive;
+}
+
+/*!
+  \fn kernel void scan_alive_particles(GGint const number_of_groups, global GGint* group_alive, global GGint* status, local GGint* scan)
+  \param number_of_groups - number of work-groups used to count alive particles
+  \param group_alive - number of alive particles in each work-group, replaced by the offset of each work-group
+  \param status - total number of alive particles
+  \param scan - local buffer of work-group size
+  \brief exclusive prefix sum of the alive particles per work-group, launched with a single work-group
+*/
+kernel void scan_alive_particles(
+  GGint const number_of_groups,
+  global GGint* group_alive,
+  global GGint* status,
+  local GGint* scan
+)
+{
+  GGint local_id = (GGint)get_local_id(0);
+  GGint local_size = (GGint)get_local_size(0);
+
+  GGint total = 0;
+  for (GGint base = 0; base < number_of_groups; base += local_size) {
+    GGint index = base + local_id;
+    GGint value = (index < number_of_groups) ? group_alive[index] : 0;
+    GGint inclusive = LocalInclusiveScan(scan, value);
+
+    if (index < number_of_groups) group_alive[index] = total + inclusive - value;
+
+    total += scan[local_size - 1];
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+
+  if (local_id == 0) status[0] = total;
+}
+
+/*!
+  \fn kernel void compact_particles(GGsize const particle_id_limit, global GGEMSPrimaryParticles const* primary_particle, global GGEMSPrimaryParticles* compacted_particle, global GGint const* group_alive, local GGint* scan)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer on primary particles
+  \param compacted_particle - pointer on particles storing only the alive particles
+  \param group_alive - offset of each work-group in compacted particles
+  \param scan - local buffer of work-group size
+  \brief copy alive particles at the beginning of the compacted particle buffer, keeping their order
+*/
+kernel void compact_particles(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles const* primary_particle,
+  global GGEMSPrimaryParticles* compacted_particle,
+  global GGint const* group_alive,
+  local GGint* scan
+)
+{
+  // Get the index of thread, no early return, all work-items take part in the scan
+  GGsize global_id = get_global_id(0);
+
+  if (global_id == 0) compacted_particle->particle_tracking_id = primary_particle->particle_tracking_id;
+
+  GGint is_alive = (global_id < particle_id_limit && primary_particle->status_[global_id] == ALIVE) ? 1 : 0;
+  GGint alive = LocalInclusiveScan(scan, is_alive);
+
+  if (!is_alive) return;
+
+  // New index of the particle
+  GGint id = group_alive[get_group_id(0)] + alive - 1;
+
+  compacted_particle->E_[id] = primary_particle->E_[global_id];
+  compacted_particle->dx_[id] = primary_particle->dx_[global_id];
+  compacted_particle->dy_[id] = primary_particle->dy_[global_id];
+  compacted_particle->dz_[id] = primary_particle->dz_[global_id];
+  compacted_particle->px_[id] = primary_particle->px_[global_id];
+  compacted_particle->py_[id] = primary_particle->py_[global_id];
+  compacted_particle->pz_[id] = primary_particle->pz_[global_id];
+  compacted_particle->scatter_[id] = primary_particle->scatter_[global_id];
+  compacted_particle->E_index_[id] = primary_particle->E_index_[global_id];
+  compacted_particle->solid_id_[id] = primary_particle->solid_id_[global_id];
+  compacted_particle->particle_solid_distance_[id] = primary_particle->particle_solid_distance_[global_id];
+  compacted_particle->next_interaction_distance_[id] = primary_particle->next_interaction_distance_[global_id];
+  compacted_particle->next_discrete_process_[id] = primary_particle->next_discrete_process_[global_id];
+  compacted_particle->status_[id] = primary_particle->status_[global_id];
+  compacted_particle->level_[id] = primary_particle->level_[global_id];
+  compacted_particle->pname_[id] = primary_particle->pname_[global_id];
+}
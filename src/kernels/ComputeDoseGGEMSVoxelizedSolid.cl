@@ -34,7 +34,7 @@
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
 
 /*!
-  \fn kernel void compute_dose_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGDosiType const* edep, global GGint const* hit, global GGDosiType const* edep_squared, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSMaterialTables const* materials, global GGfloat* dose, global GGfloat* uncertainty, GGfloat const scale_factor, GGchar const is_water_reference, GGfloat const minimum_density)
+  \fn kernel void compute_dose_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGDosiTallyType const* edep, global GGint const* hit, global GGDosiTallyType const* edep_squared, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGLabelType const* label_data, global GGEMSMaterialTables const* materials, global GGfloat* dose, global GGfloat* uncertainty, GGfloat const scale_factor, GGchar const is_water_reference, GGfloat const minimum_density, GGint const number_of_batches)
   \param dosel_id_limit - number total of dosels
   \param dose_params - params about dosemap
   \param edep - buffer storing energy deposit
@@ -48,22 +48,24 @@
   \param scale_factor - scale factor apply to dose
   \param is_water_reference - water reference mode
   \param minimum_density - minimum density threshold
+  \param number_of_batches - number of batches for batch uncertainty, 0 if uncertainty is computed history by history
   \brief computing dose for voxelized solid
 */
 kernel void compute_dose_ggems_voxelized_solid(
   GGsize const dosel_id_limit,
   global GGEMSDoseParams const* dose_params,
-  global GGDosiType const* edep,
+  global GGDosiTallyType const* edep,
   global GGint const* hit,
-  global GGDosiType const* edep_squared,
+  global GGDosiTallyType const* edep_squared,
   global GGEMSVoxelizedSolidData const* voxelized_solid_data,
-  global GGuchar const* label_data,
+  global GGLabelType const* label_data,
   global GGEMSMaterialTables const* materials,
   global GGfloat* dose,
   global GGfloat* uncertainty,
   GGfloat const scale_factor,
   GGchar const is_water_reference,
-  GGfloat const minimum_density
+  GGfloat const minimum_density,
+  GGint const number_of_batches
 )
 {
   // Getting index of thread
@@ -84,7 +86,7 @@ kernel void compute_dose_ggems_voxelized_solid(
   GGint3 voxel_id = convert_int3((dosel_pos - voxelized_solid_data->obb_geometry_.border_min_xyz_) / voxelized_solid_data->voxel_sizes_xyz_);
 
   // Get the material that compose this volume
-  GGuchar material_id = label_data[
+  GGLabelType material_id = label_data[
     voxel_id.x +
     voxel_id.y * voxelized_solid_data->number_of_voxels_xyz_.x +
     voxel_id.z * voxelized_solid_data->number_of_voxels_xyz_.x * voxelized_solid_data->number_of_voxels_xyz_.y
@@ -96,8 +98,11 @@ kernel void compute_dose_ggems_voxelized_solid(
   // Get density
   GGfloat density = is_water_reference ? 1.0f * (g/cm3) : materials->density_of_material_[material_id];
 
+  // Energy deposit converted from tally unit (fixed-point or floating point)
+  GGDosiType edep_dosel = ConvertTallyToDose(edep[global_id]);
+
   // Apply threshold on density and computing dose
-  dose[global_id] = density < minimum_density ? 0.0f : scale_factor * edep[global_id] / density / dosel_vol / Gy;
+  dose[global_id] = density < minimum_density ? 0.0f : scale_factor * edep_dosel / density / dosel_vol / Gy;
 
   // Relative statistical uncertainty (from Ma et al. PMB 47 2002 p1671)
   //              /                                    \ ^1/2
@@ -107,12 +112,14 @@ kernel void compute_dose_ggems_voxelized_solid(
   //              \         (N-1)*Sum(Edep)^2          /
   //
   //   where Edep represents the energy deposit in one hit and N the number of energy deposits (hits)
+  //   In batch mode, Edep represents the energy deposit of one batch and N the number of batches
 
   // Computing uncertainty
   if (uncertainty) {
-    if (hit[global_id] > 1 && edep[global_id] != 0.0) {
-      GGDosiType sum_edep_2 = edep[global_id] * edep[global_id];
-      uncertainty[global_id] = sqrt((hit[global_id]*edep_squared[global_id] - sum_edep_2) / ((hit[global_id]-1) * sum_edep_2));
+    GGint number_of_samples = number_of_batches > 0 ? number_of_batches : hit[global_id];
+    if (number_of_samples > 1 && edep_dosel != 0.0) {
+      GGDosiType sum_edep_2 = edep_dosel * edep_dosel;
+      uncertainty[global_id] = sqrt((number_of_samples*ConvertTallyToSquaredDose(edep_squared[global_id]) - sum_edep_2) / ((number_of_samples-1) * sum_edep_2));
     }
     else {
       uncertainty[global_id] = 1.0f;
@@ -0,0 +1,82 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file InitializeRandom.cl
+
+  \brief OpenCL kernel seeding the JKISS random state of each particle
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday April 30, 2021
+*/
+
+#include "GGEMS/randoms/GGEMSRandom.hh"
+
+/*!
+  \fn inline GGulong SplitMix64(GGulong* state)
+  \param state - pointer on 64 bits state
+  \return 64 random bits
+  \brief SplitMix64 generator (Steele et al., OOPSLA 2014), used only to spread the seed over the states of particles
+*/
+inline GGulong SplitMix64(GGulong* state)
+{
+  *state += 0x9E3779B97F4A7C15UL;
+  GGulong z = *state;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+  return z ^ (z >> 31);
+}
+
+/*!
+  \fn kernel void initialize_random(GGsize const particle_id_limit, global GGEMSRandom* random, GGuint const seed, GGuint const device_id)
+  \param particle_id_limit - particle id limit
+  \param random - pointer on random buffer
+  \param seed - seed of simulation
+  \param device_id - index of activated device, states are different on each device
+  \brief derive JKISS state of each particle from the seed, the device and the particle index
+*/
+kernel void initialize_random(
+  GGsize const particle_id_limit,
+  global GGEMSRandom* random,
+  GGuint const seed,
+  GGuint const device_id)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // One SplitMix64 stream per particle and device
+  GGulong state = (((GGulong)seed << 32) | (GGulong)device_id) ^ (global_id * 0xD1B54A32D192ED03UL);
+
+  GGulong bits_12 = SplitMix64(&state);
+  GGulong bits_34 = SplitMix64(&state);
+
+  random->prng_state_1_[global_id] = (GGuint)bits_12;
+  random->prng_state_2_[global_id] = (GGuint)(bits_12 >> 32);
+  random->prng_state_3_[global_id] = (GGuint)bits_34;
+  random->prng_state_4_[global_id] = (GGuint)(bits_34 >> 32);
+  random->prng_state_5_[global_id] = 0;
+
+  // Xorshift part of JKISS must not start from 0
+  if (random->prng_state_2_[global_id] == 0) random->prng_state_2_[global_id] = 0x6C078965u;
+}
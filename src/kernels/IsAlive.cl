@@ -32,23 +32,34 @@
 #include "GGEMS/physics/GGEMSParticleConstants.hh"
 
 /*!
-  \fn kernel void is_alive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGint* status)
+  \fn kernel void is_alive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGint* status, local GGint* dead_particles)
   \param particle_id_limit - particle id limit
   \param primary_particle - pointer on primary particles
-  \param status - status of particle
-  \brief checking if particle is alive
+  \param status - number of dead particles
+  \param dead_particles - local buffer of work-group size
+  \brief counting dead particles, reduction in work-group then one atomic per work-group
 */
 kernel void is_alive(
   GGsize const particle_id_limit,
   global GGEMSPrimaryParticles* primary_particle,
-  global GGint* status
+  global GGint* status,
+  local GGint* dead_particles
 )
 {
-  // Get the index of thread
+  // Get the index of thread, no early return, all work-items take part in the reduction
   GGsize global_id = get_global_id(0);
+  GGsize local_id = get_local_id(0);
 
-  // Return if index > to particle limit
-  if (global_id >= particle_id_limit) return;
+  dead_particles[local_id] = (global_id < particle_id_limit) ? primary_particle->status_[global_id] : 0;
+  barrier(CLK_LOCAL_MEM_FENCE);
 
-  atomic_add(&status[0], primary_particle->status_[global_id]);
+  // Reduction in local memory, work-group size is not always a power of 2
+  for (GGsize size = get_local_size(0); size > 1;) {
+    GGsize half = (size + 1) / 2;
+    if (local_id < size - half) dead_particles[local_id] += dead_particles[local_id + half];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    size = half;
+  }
+
+  if (local_id == 0 && dead_particles[0] != 0) atomic_add(&status[0], dead_particles[0]);
 }
@@ -28,10 +28,7 @@
   \date Friday November 20, 2020
 */
 
-#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
-
-#include "GGEMS/geometries/GGEMSSolidBoxData.hh"
-#include "GGEMS/geometries/GGEMSRayTracing.hh"
+#include "GGEMS/navigators/GGEMSSolidBoxNavigator.hh"
 
 /*!
   \fn kernel void particle_solid_distance_ggems_solid_box(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidBoxData const* solid_box_data)
@@ -72,37 +69,5 @@ kernel void particle_solid_distance_ggems_solid_box(
     primary_particle->dz_[global_id]
   };
 
-  // Check if particle inside voxelized navigator, if yes distance is 0.0 and not need to compute particle - solid distance
-  if (IsParticleInOBB(&position, &solid_box_data->obb_geometry_)) {
-    #ifdef GGEMS_TRACKING
-    if (global_id == primary_particle->particle_tracking_id) {
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] --------------------------------------------------------------------------------\n");
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Find a closest solid\n");
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle id: %d\n", global_id);
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle in voxelized solid, id: %d\n", solid_box_data->solid_id_);
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle solid distance: 0.0\n");
-    }
-    #endif
-    primary_particle->particle_solid_distance_[global_id] = 0.0f;
-    primary_particle->solid_id_[global_id] = solid_box_data->solid_id_;
-    return;
-  }
-
-  // Compute distance between particles and voxelized navigator
-  GGfloat distance = ComputeDistanceToOBB(&position, &direction, &solid_box_data->obb_geometry_);
-
-  // Check distance value with previous value. Store the minimum value
-  if (distance < primary_particle->particle_solid_distance_[global_id]) {
-    #ifdef GGEMS_TRACKING
-    if (global_id == primary_particle->particle_tracking_id) {
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] --------------------------------------------------------------------------------\n");
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Find a closest solid\n");
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle id: %d\n", global_id);
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle in voxelized solid, id: %d\n", solid_box_data->solid_id_);
-      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_box] Particle solid distance: %e mm\n", distance/mm);
-    }
-    #endif
-    primary_particle->particle_solid_distance_[global_id] = distance;
-    primary_particle->solid_id_[global_id] = solid_box_data->solid_id_;
-  }
+  ParticleSolidBoxDistance(global_id, primary_particle, &position, &direction, solid_box_data);
 }
@@ -0,0 +1,79 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ParticleSolidDistanceGGEMSSolidBoxTable.cl
+
+  \brief OpenCL kernel computing distance between a table of solid boxes and particles
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSSolidBoxNavigator.hh"
+
+/*!
+  \fn kernel void particle_solid_distance_ggems_solid_box_table(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidBoxData const* solid_box_table, GGint const number_of_solids)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param solid_box_table - pointer to table of solid box data
+  \param number_of_solids - number of solid boxes in table
+  \brief OpenCL kernel computing distance between all the solid boxes of a navigator and particles
+*/
+kernel void particle_solid_distance_ggems_solid_box_table(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSSolidBoxData const* solid_box_table,
+  GGint const number_of_solids
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking particle status. If DEAD, the particle is not track
+  if (primary_particle->status_[global_id] == DEAD) return;
+
+  // Checking if the particle - solid is 0. If yes the particle is already in another navigator
+  if (primary_particle->particle_solid_distance_[global_id] == 0.0f) return;
+
+  // Position of particle
+  GGfloat3 position = {
+    primary_particle->px_[global_id],
+    primary_particle->py_[global_id],
+    primary_particle->pz_[global_id]
+  };
+
+  // Direction of particle
+  GGfloat3 direction = {
+    primary_particle->dx_[global_id],
+    primary_particle->dy_[global_id],
+    primary_particle->dz_[global_id]
+  };
+
+  // Loop over all the solids of the table, stop if particle is inside a solid
+  for (GGint i = 0; i < number_of_solids; ++i) {
+    ParticleSolidBoxDistance(global_id, primary_particle, &position, &direction, &solid_box_table[i]);
+    if (primary_particle->particle_solid_distance_[global_id] == 0.0f) break;
+  }
+}
@@ -0,0 +1,62 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ProjectToGGEMSSolidBoxTable.cl
+
+  \brief OpenCL kernel moving particles to a solid box from a table of solid boxes
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSSolidBoxNavigator.hh"
+
+/*!
+  \fn kernel void project_to_ggems_solid_box_table(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidBoxData const* solid_box_table, GGint const number_of_solids)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param solid_box_table - pointer to table of solid box data, solid ids are consecutive
+  \param number_of_solids - number of solid boxes in table
+  \brief OpenCL kernel moving particles to the selected solid box of a navigator
+*/
+kernel void project_to_ggems_solid_box_table(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSSolidBoxData const* solid_box_table,
+  GGint const number_of_solids
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Particle out of world is dead, no projection
+  if (KillParticleOutOfWorld(global_id, primary_particle)) return;
+
+  // Checking if the selected solid is in the table of the current navigator
+  GGint table_index = primary_particle->solid_id_[global_id] - solid_box_table[0].solid_id_;
+  if (table_index < 0 || table_index >= number_of_solids) return;
+
+  ProjectToSolidBox(global_id, primary_particle, &solid_box_table[table_index]);
+}
@@ -0,0 +1,85 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file TrackThroughGGEMSSolidBoxTable.cl
+
+  \brief OpenCL kernel tracking particles within a table of solid boxes
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Friday October 16, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSSolidBoxNavigator.hh"
+#include "GGEMS/physics/GGEMSMuData.hh"
+
+/*!
+  \fn kernel void track_through_ggems_solid_box_table(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSSolidBoxData const* solid_box_table, GGint const number_of_solids, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold, global GGint* histogram, global GGint* scatter_histogram)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param solid_box_table - pointer to table of solid box data, solid ids are consecutive
+  \param number_of_solids - number of solid boxes in table
+  \param label_data - pointer storing label of material (empty buffer here, 1 material only)
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param attenuations - pointer on attenuation values
+  \param threshold - energy threshold
+  \param histogram - pointer to buffer storing histograms of all the solids, one after the other
+  \param scatter_histogram - pointer to buffer storing scatter histograms of all the solids, one after the other
+  \brief OpenCL kernel tracking particles within the selected solid box of a navigator
+*/
+kernel void track_through_ggems_solid_box_table(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSSolidBoxData const* solid_box_table,
+  GGint const number_of_solids,
+  global GGuchar const* label_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  global GGEMSMuMuEnData const* attenuations,
+  GGfloat const threshold
+  #ifdef HISTOGRAM
+  ,global GGint* histogram,
+  global GGint* scatter_histogram
+  #endif
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking if the selected solid is in the table of the current navigator
+  GGint table_index = primary_particle->solid_id_[global_id] - solid_box_table[0].solid_id_;
+  if (table_index < 0 || table_index >= number_of_solids) return;
+  global GGEMSSolidBoxData const* solid_box_data = &solid_box_table[table_index];
+
+  #ifdef HISTOGRAM
+  // Histogram of the solid in the buffer storing all histograms
+  GGint histogram_offset = table_index * solid_box_data->virtual_element_number_xyz_[0] * solid_box_data->virtual_element_number_xyz_[1] * solid_box_data->virtual_element_number_xyz_[2];
+  TrackThroughSolidBox(global_id, primary_particle, random, solid_box_data, particle_cross_sections, materials, threshold, histogram + histogram_offset, scatter_histogram ? scatter_histogram + histogram_offset : scatter_histogram);
+  #else
+  TrackThroughSolidBox(global_id, primary_particle, random, solid_box_data, particle_cross_sections, materials, threshold, NULL, NULL);
+  #endif
+}
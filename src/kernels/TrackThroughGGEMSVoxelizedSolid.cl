@@ -43,7 +43,124 @@
 #endif
 
 /*!
-  \fn kernel void track_through_ggems_voxelized_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
+  \fn inline void voxelized_solid_photon_interaction(GGsize const global_id, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, GGLabelType const material_id, GGchar const next_discrete_process, GGfloat3 const* local_position, GGfloat3* local_direction)
+  \param global_id - index of particle
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param voxelized_solid_data - pointer to voxelized solid data
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param material_id - index of material at interaction point
+  \param next_discrete_process - selected photon process
+  \param local_position - position of interaction in local coordinate
+  \param local_direction - direction of particle in local coordinate, updated after interaction
+  \brief Resolve a real photon interaction, recording dose (not in TLE mode) and OpenGL point, shared by standard and Woodcock tracking
+*/
+inline void voxelized_solid_photon_interaction(
+  GGsize const global_id,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSVoxelizedSolidData const* voxelized_solid_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  GGLabelType const material_id,
+  GGchar const next_discrete_process,
+  GGfloat3 const* local_position,
+  GGfloat3* local_direction
+  #ifdef DOSIMETRY
+  ,global GGEMSDoseParams* dose_params,
+  global GGDosiTallyType* edep_tracking,
+  global GGDosiTallyType* edep_squared_tracking,
+  global GGint* hit_tracking,
+  local GGEMSDoseLocalTally* dose_local_tally
+  #endif
+)
+{
+  #if defined(DOSIMETRY) && !defined(TLE)
+  GGfloat initial_energy = primary_particle->E_[global_id];
+  #endif
+
+  PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, material_id, global_id);
+
+  // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter order is incremented
+  if (next_discrete_process == COMPTON_SCATTERING || next_discrete_process == RAYLEIGH_SCATTERING)
+  {
+    primary_particle->scatter_[global_id] = TRUE;
+  }
+
+  #if defined(DOSIMETRY) && !defined(TLE)
+  GGfloat edep = initial_energy - primary_particle->E_[global_id];
+  dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally, edep, local_position);
+  #endif
+
+  local_direction->x = primary_particle->dx_[global_id];
+  local_direction->y = primary_particle->dy_[global_id];
+  local_direction->z = primary_particle->dz_[global_id];
+
+  #if defined(OPENGL)
+  if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+    // Storing OpenGL index on OpenCL private memory
+    GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+    // Checking if buffer is full
+    if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+      // Getting global position
+      GGfloat3 global_position = LocalToGlobalPosition(&voxelized_solid_data->obb_geometry_.matrix_transformation_, local_position);
+
+      primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.x;
+      primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.y;
+      primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.z;
+
+      // Storing final index
+      primary_particle->stored_particles_gl_[global_id] += 1;
+    }
+  }
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void voxelized_solid_energy_cut(GGsize const global_id, global GGEMSPrimaryParticles* primary_particle, global GGEMSMaterialTables const* materials, GGLabelType const material_id, GGfloat3 const* local_position)
+  \param global_id - index of particle
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param materials - pointer on material in navigator
+  \param material_id - index of material at particle position
+  \param local_position - position of particle in local coordinate
+  \brief Kill the particle below the energy cut of the material, depositing its remaining energy, shared by standard and Woodcock tracking
+*/
+inline void voxelized_solid_energy_cut(
+  GGsize const global_id,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSMaterialTables const* materials,
+  GGLabelType const material_id,
+  GGfloat3 const* local_position
+  #ifdef DOSIMETRY
+  ,global GGEMSDoseParams* dose_params,
+  global GGDosiTallyType* edep_tracking,
+  global GGDosiTallyType* edep_squared_tracking,
+  global GGint* hit_tracking,
+  local GGEMSDoseLocalTally* dose_local_tally
+  #endif
+)
+{
+  if (primary_particle->E_[global_id] > materials->photon_energy_cut_[material_id]) return;
+
+  #if defined(DOSIMETRY)
+  dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally, primary_particle->E_[global_id], local_position);
+  #endif
+  primary_particle->status_[global_id] = DEAD;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void track_through_ggems_voxelized_solid_particle(GGsize const global_id, GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGLabelType const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
+  \param global_id - index of particle
   \param particle_id_limit - particle id limit
   \param primary_particle - pointer to primary particles on OpenCL memory
   \param random - pointer on random numbers
@@ -53,30 +170,29 @@
   \param materials - pointer on material in navigator
   \param attenuations - pointer on attenuation values
   \param threshold - energy threshold
-  \brief OpenCL kernel tracking particles within voxelized solid
+  \brief Tracking one particle within voxelized solid
 */
-kernel void track_through_ggems_voxelized_solid(
+inline void track_through_ggems_voxelized_solid_particle(
+  GGsize const global_id,
   GGsize const particle_id_limit,
   global GGEMSPrimaryParticles* primary_particle,
   global GGEMSRandom* random,
   global GGEMSVoxelizedSolidData const* voxelized_solid_data,
-  global GGuchar const* label_data,
+  global GGLabelType const* label_data,
   global GGEMSParticleCrossSections const* particle_cross_sections,
   global GGEMSMaterialTables const* materials,
   global GGEMSMuMuEnData const* attenuations,
   GGfloat const threshold
   #ifdef DOSIMETRY
   ,global GGEMSDoseParams* dose_params,
-  global GGDosiType* edep_tracking,
-  global GGDosiType* edep_squared_tracking,
+  global GGDosiTallyType* edep_tracking,
+  global GGDosiTallyType* edep_squared_tracking,
   global GGint* hit_tracking,
-  global GGint* photon_tracking
+  global GGint* photon_tracking,
+  local GGEMSDoseLocalTally* dose_local_tally
   #endif
 )
 {
-  // Getting index of thread
-  GGsize global_id = get_global_id(0);
-
   // Return if index > to particle limit
   if (global_id >= particle_id_limit) return;
 
@@ -112,6 +228,85 @@ kernel void track_through_ggems_voxelized_solid(
   GGfloat3 voxel_size = voxelized_solid_data->voxel_sizes_xyz_;
   GGint3 number_of_voxels = voxelized_solid_data->number_of_voxels_xyz_;
 
+  #if defined(WOODCOCK)
+  // Woodcock tracking, tentative interactions sampled with majorant cross section, no voxel boundary crossing
+  do {
+    // Sampling distance to next tentative interaction
+    GGfloat next_interaction_distance = GetPhotonMajorantInteractionDistance(primary_particle, random, particle_cross_sections, global_id);
+
+    // Get the distance to solid boundary
+    GGfloat distance_to_solid_boundary = ComputeDistanceToAABB(
+      &local_position, &local_direction,
+      border_min.x, border_max.x,
+      border_min.y, border_max.y,
+      border_min.z, border_max.z,
+      GEOMETRY_TOLERANCE
+    );
+
+    // Particle leaves the solid before next tentative interaction
+    if (distance_to_solid_boundary <= next_interaction_distance) {
+      local_position = local_position + local_direction*(distance_to_solid_boundary + GEOMETRY_TOLERANCE);
+      primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD; // Reset to initiale value
+      primary_particle->solid_id_[global_id] = -1; // Out of world
+      break;
+    }
+
+    // Moving particle to tentative interaction point
+    local_position = local_position + local_direction*next_interaction_distance;
+
+    // Storing new position in local
+    primary_particle->px_[global_id] = local_position.x;
+    primary_particle->py_[global_id] = local_position.y;
+    primary_particle->pz_[global_id] = local_position.z;
+
+    // Get index of voxelized phantom, x, y, z, clamped against rounding on solid borders
+    GGint3 voxel_id = clamp(convert_int3((local_position - border_min) / voxel_size), (GGint3)(0), number_of_voxels - 1);
+
+    // Get the material at tentative interaction point
+    GGLabelType material_id = label_data[voxel_id.x + voxel_id.y * number_of_voxels.x + voxel_id.z * number_of_voxels.x * number_of_voxels.y];
+
+    // Real or fictitious interaction
+    GGchar next_discrete_process = GetPhotonWoodcockProcess(primary_particle, random, particle_cross_sections, material_id, global_id);
+
+    #if defined(GGEMS_TRACKING)
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Woodcock tentative position (x, y, z): %e %e %e mm\n", local_position.x/mm, local_position.y/mm, local_position.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Energy: %e keV\n", primary_particle->E_[global_id]/keV);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Index of current voxel (x, y, z): %d %d %d\n", voxel_id.x, voxel_id.y, voxel_id.z);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Material in voxel: %u\n", material_id);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Next process: ");
+      if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
+      if (next_discrete_process == PHOTOELECTRIC_EFFECT) printf("PHOTOELECTRIC_EFFECT\n");
+      if (next_discrete_process == RAYLEIGH_SCATTERING) printf("RAYLEIGH_SCATTERING\n");
+      if (next_discrete_process == NO_PROCESS) printf("FICTITIOUS\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Next interaction distance: %e mm\n", next_interaction_distance/mm);
+    }
+    #endif
+
+    // Fictitious interaction, particle continues unchanged
+    if (next_discrete_process == NO_PROCESS) continue;
+
+    primary_particle->next_discrete_process_[global_id] = next_discrete_process;
+
+    voxelized_solid_photon_interaction(
+      global_id, primary_particle, random, voxelized_solid_data, particle_cross_sections, materials,
+      material_id, next_discrete_process, &local_position, &local_direction
+      #ifdef DOSIMETRY
+      ,dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally
+      #endif
+    );
+
+    // Apply threshold
+    voxelized_solid_energy_cut(
+      global_id, primary_particle, materials, material_id, &local_position
+      #ifdef DOSIMETRY
+      ,dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally
+      #endif
+    );
+  } while (primary_particle->status_[global_id] == ALIVE);
+  #else
   // Track particle until out of solid
   do {
     // Get index of voxelized phantom, x, y, z
@@ -124,7 +319,7 @@ kernel void track_through_ggems_voxelized_solid(
     }
 
     // Get the material that compose this volume
-    GGuchar material_id = label_data[voxel_id.x + voxel_id.y * number_of_voxels.x + voxel_id.z * number_of_voxels.x * number_of_voxels.y];
+    GGLabelType material_id = label_data[voxel_id.x + voxel_id.y * number_of_voxels.x + voxel_id.z * number_of_voxels.x * number_of_voxels.y];
 
     // Find next discrete photon interaction
     GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, material_id, global_id);
@@ -184,7 +379,7 @@ kernel void track_through_ggems_voxelized_solid(
       printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Voxel Y Borders: %e %e mm\n", voxel_border_min.y/mm, voxel_border_max.y/mm);
       printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Voxel Z Borders: %e %e mm\n", voxel_border_min.z/mm, voxel_border_max.z/mm);
       printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Index of current voxel (x, y, z): %d %d %d\n", voxel_id.x, voxel_id.y, voxel_id.z);
-      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Material in voxel: %s\n", particle_cross_sections->material_names_[material_id]);
+      printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Material in voxel: %u\n", material_id);
       printf("\n");
       printf("[GGEMS OpenCL kernel track_through_ggems_voxelized_solid] Next process: ");
       if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
@@ -219,53 +414,23 @@ kernel void track_through_ggems_voxelized_solid(
     primary_particle->py_[global_id] = local_position.y;
     primary_particle->pz_[global_id] = local_position.z;
 
-    #if defined(DOSIMETRY)
+    #if defined(DOSIMETRY) && defined(TLE)
     GGfloat initial_energy = primary_particle->E_[global_id];
     #endif
 
     // Resolve process if different of TRANSPORTATION
     if (next_discrete_process != TRANSPORTATION) {
-
-      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, material_id, global_id);
-
-      // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter order is incremented
-      if (next_discrete_process == COMPTON_SCATTERING || next_discrete_process == RAYLEIGH_SCATTERING)
-      {
-        primary_particle->scatter_[global_id] = TRUE;
-      }
-
-      #if defined(DOSIMETRY) && !defined(TLE)
-      GGfloat edep = initial_energy - primary_particle->E_[global_id];
-      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, edep, &local_position);
-      #endif
-
-      local_direction.x = primary_particle->dx_[global_id];
-      local_direction.y = primary_particle->dy_[global_id];
-      local_direction.z = primary_particle->dz_[global_id];
-
-      #if defined(OPENGL)
-      if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
-        // Storing OpenGL index on OpenCL private memory
-        GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
-
-        // Checking if buffer is full
-        if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
-          // Getting global position
-          global_position = LocalToGlobalPosition(&voxelized_solid_data->obb_geometry_.matrix_transformation_, &local_position);
-
-          primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.x;
-          primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.y;
-          primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.z;
-
-          // Storing final index
-          primary_particle->stored_particles_gl_[global_id] += 1;
-        }
-      }
-      #endif
+      voxelized_solid_photon_interaction(
+        global_id, primary_particle, random, voxelized_solid_data, particle_cross_sections, materials,
+        material_id, next_discrete_process, &local_position, &local_direction
+        #ifdef DOSIMETRY
+        ,dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally
+        #endif
+      );
     }
 
     #if defined(DOSIMETRY) && defined(TLE)
-    GGint E_index = BinarySearchLeft(initial_energy, attenuations->energy_bins_, attenuations->number_of_bins_, 0, 0);
+    GGint E_index = LogScaleIndex(initial_energy, attenuations->log_energy_min_, attenuations->inverse_log_energy_step_, attenuations->number_of_bins_);
     GGfloat mu_en = 0.0f;
     if (E_index == 0) {
       mu_en = attenuations->mu_en_[material_id*attenuations->number_of_bins_];
@@ -278,17 +443,18 @@ kernel void track_through_ggems_voxelized_solid(
       );
     }
     GGfloat edep = initial_energy * mu_en * next_interaction_distance * 0.1f;
-    dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, edep, &local_position);
+    dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally, edep, &local_position);
     #endif
 
     // Apply threshold
-    if (primary_particle->E_[global_id] <= materials->photon_energy_cut_[material_id]) {
-      #if defined(DOSIMETRY)
-      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, primary_particle->E_[global_id], &local_position);
+    voxelized_solid_energy_cut(
+      global_id, primary_particle, materials, material_id, &local_position
+      #ifdef DOSIMETRY
+      ,dose_params, edep_tracking, edep_squared_tracking, hit_tracking, dose_local_tally
       #endif
-      primary_particle->status_[global_id] = DEAD;
-    }
+    );
   } while (primary_particle->status_[global_id] == ALIVE);
+  #endif
 
   // Convert to global position
   global_position = LocalToGlobalPosition(&voxelized_solid_data->obb_geometry_.matrix_transformation_, &local_position);
@@ -302,3 +468,77 @@ kernel void track_through_ggems_voxelized_solid(
   primary_particle->dy_[global_id] = global_direction.y;
   primary_particle->dz_[global_id] = global_direction.z;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn kernel void track_through_ggems_voxelized_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGLabelType const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param voxelized_solid_data - pointer to voxelized solid data
+  \param label_data - pointer storing label of material
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param attenuations - pointer on attenuation values
+  \param threshold - energy threshold
+  \brief OpenCL kernel tracking particles within voxelized solid
+*/
+kernel void track_through_ggems_voxelized_solid(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSVoxelizedSolidData const* voxelized_solid_data,
+  global GGLabelType const* label_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  global GGEMSMuMuEnData const* attenuations,
+  GGfloat const threshold
+  #ifdef DOSIMETRY
+  ,global GGEMSDoseParams* dose_params,
+  global GGDosiTallyType* edep_tracking,
+  global GGDosiTallyType* edep_squared_tracking,
+  global GGint* hit_tracking,
+  global GGint* photon_tracking
+  #endif
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  #if defined(DOSIMETRY) && defined(DOSE_LOCAL_TALLY)
+  // Dosels cached by work-group, all work-items must reach initialization and flush
+  local GGEMSDoseLocalTally dose_local_tally;
+  dose_local_tally_initialize(&dose_local_tally);
+  local GGEMSDoseLocalTally* dose_local_tally_ptr = &dose_local_tally;
+  #elif defined(DOSIMETRY)
+  local GGEMSDoseLocalTally* dose_local_tally_ptr = NULL;
+  #endif
+
+  track_through_ggems_voxelized_solid_particle(
+    global_id,
+    particle_id_limit,
+    primary_particle,
+    random,
+    voxelized_solid_data,
+    label_data,
+    particle_cross_sections,
+    materials,
+    attenuations,
+    threshold
+    #ifdef DOSIMETRY
+    ,dose_params,
+    edep_tracking,
+    edep_squared_tracking,
+    hit_tracking,
+    photon_tracking,
+    dose_local_tally_ptr
+    #endif
+  );
+
+  #if defined(DOSIMETRY) && defined(DOSE_LOCAL_TALLY)
+  dose_local_tally_flush(&dose_local_tally, edep_tracking, edep_squared_tracking, hit_tracking);
+  #endif
+}
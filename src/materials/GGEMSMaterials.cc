@@ -102,8 +102,10 @@ void GGEMSMaterials::Clean(void)
 void GGEMSMaterials::AddMaterial(std::string const& material_name)
 {
   // Checking the number of material
-  if (materials_.size() == 255) {
-    GGEMSMisc::ThrowException("GGEMSMaterials", "AddMaterial", "Limit of material reached. The limit is 255 materials!!!");
+  if (materials_.size() == MAXIMUM_MATERIALS) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Limit of material reached. The limit is " << MAXIMUM_MATERIALS << " materials!!! Recompile GGEMS setting MAXIMUM_MATERIALS to a higher value.";
+    GGEMSMisc::ThrowException("GGEMSMaterials", "AddMaterial", oss.str());
   }
 
   // Add material and check if the material already exists
@@ -226,7 +228,7 @@ void GGEMSMaterials::BuildMaterialTables(void)
     GGEMSMaterialTables* material_table_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(material_tables_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), d);
 
     // Get the number of activated materials
-    material_table_device->number_of_materials_ = static_cast<GGuchar>(materials_.size());
+    material_table_device->number_of_materials_ = materials_.size();
 
     // Loop over the materials
     GGsize index_to_chemical_element = 0;
@@ -298,6 +298,9 @@ void GGEMSCTSystem::Initialize(void)
 
   // Initialize parent class
   GGEMSNavigator::Initialize();
+
+  // Gathering all the modules in a single table of solids
+  if (is_solid_table_) InitializeSolidTable();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,6 +415,15 @@ void store_scatter_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_scatt
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void enable_solid_table_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_solid_table)
+{
+  ct_system->EnableSolidTable(is_solid_table);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void set_visible_ggems_ct_system(GGEMSCTSystem* ct_system, bool const flag)
 {
   ct_system->SetVisible(flag);
@@ -45,10 +45,14 @@ GGEMSDosimetryCalculator::GGEMSDosimetryCalculator(void)
   is_hit_tracking_(false),
   is_edep_squared_(false),
   is_uncertainty_(false),
+  is_local_tally_(false),
+  is_fixed_point_(false),
+  is_batch_uncertainty_(false),
   scale_factor_(1.0f),
   is_water_reference_(FALSE),
   minimum_density_(0.0f),
-  kernel_compute_dose_(nullptr)
+  kernel_compute_dose_(nullptr),
+  kernel_accumulate_batch_(nullptr)
 {
   GGcout("GGEMSDosimetryCalculator", "GGEMSDosimetryCalculator", 3) << "GGEMSDosimetryCalculator creating..." << GGendl;
 
@@ -80,9 +84,14 @@ GGEMSDosimetryCalculator::GGEMSDosimetryCalculator(void)
   dose_recording_.dose_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.uncertainty_dose_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.edep_squared_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.edep_batch_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.hit_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.photon_tracking_ = new cl::Buffer*[number_activated_devices_];
 
+  // Counting batches on each device for batch uncertainty
+  number_of_batches_ = new GGint[number_activated_devices_];
+  for (GGsize i = 0; i < number_activated_devices_; ++i) number_of_batches_[i] = 0;
+
   GGcout("GGEMSDosimetryCalculator", "GGEMSDosimetryCalculator", 3) << "GGEMSDosimetryCalculator created!!!" << GGendl;
 }
 
@@ -106,25 +115,21 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
 
   if (dose_recording_.edep_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(dose_recording_.edep_[i], total_number_of_dosels_*sizeof(GGDosiType), i);
+      opencl_manager.Deallocate(dose_recording_.edep_[i], total_number_of_dosels_*GetTallyTypeSize(), i);
     }
     delete[] dose_recording_.edep_;
     dose_recording_.edep_ = nullptr;
   }
 
   if (dose_recording_.dose_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(dose_recording_.dose_[i], total_number_of_dosels_*sizeof(GGfloat), i);
-    }
+    if (dose_recording_.dose_[0]) opencl_manager.Deallocate(dose_recording_.dose_[0], total_number_of_dosels_*sizeof(GGfloat), 0);
     delete[] dose_recording_.dose_;
     dose_recording_.dose_ = nullptr;
   }
 
   if (dose_recording_.uncertainty_dose_) {
-    if (is_uncertainty_) {
-      for (GGsize i = 0; i < number_activated_devices_; ++i) {
-        opencl_manager.Deallocate(dose_recording_.uncertainty_dose_[i], total_number_of_dosels_*sizeof(GGfloat), i);
-      }
+    if (is_uncertainty_ && dose_recording_.uncertainty_dose_[0]) {
+      opencl_manager.Deallocate(dose_recording_.uncertainty_dose_[0], total_number_of_dosels_*sizeof(GGfloat), 0);
     }
     delete[] dose_recording_.uncertainty_dose_;
     dose_recording_.uncertainty_dose_ = nullptr;
@@ -133,15 +138,30 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
   if (dose_recording_.edep_squared_) {
     if (is_edep_squared_||is_uncertainty_) {
       for (GGsize i = 0; i < number_activated_devices_; ++i) {
-        opencl_manager.Deallocate(dose_recording_.edep_squared_[i], total_number_of_dosels_*sizeof(GGDosiType), i);
+        opencl_manager.Deallocate(dose_recording_.edep_squared_[i], total_number_of_dosels_*GetTallyTypeSize(), i);
       }
     }
     delete[] dose_recording_.edep_squared_;
     dose_recording_.edep_squared_ = nullptr;
   }
 
+  if (dose_recording_.edep_batch_) {
+    if (IsBatchUncertainty()) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(dose_recording_.edep_batch_[i], total_number_of_dosels_*GetTallyTypeSize(), i);
+      }
+    }
+    delete[] dose_recording_.edep_batch_;
+    dose_recording_.edep_batch_ = nullptr;
+  }
+
+  if (number_of_batches_) {
+    delete[] number_of_batches_;
+    number_of_batches_ = nullptr;
+  }
+
   if (dose_recording_.hit_) {
-    if (is_hit_tracking_||is_uncertainty_) {
+    if (is_hit_tracking_||(is_uncertainty_ && !IsBatchUncertainty())) {
       for (GGsize i = 0; i < number_activated_devices_; ++i) {
         opencl_manager.Deallocate(dose_recording_.hit_[i], total_number_of_dosels_*sizeof(GGint), i);
       }
@@ -165,6 +185,11 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
     kernel_compute_dose_ = nullptr;
   }
 
+  if (kernel_accumulate_batch_) {
+    delete[] kernel_accumulate_batch_;
+    kernel_accumulate_batch_ = nullptr;
+  }
+
   GGcout("GGEMSDosimetryCalculator", "~GGEMSDosimetryCalculator", 3) << "GGEMSSourceManager erased!!!" << GGendl;
 }
 
@@ -264,6 +289,33 @@ void GGEMSDosimetryCalculator::SetTLE(bool const& is_activated)
   navigator_->EnableTLE(is_activated);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetLocalTally(bool const& is_activated)
+{
+  is_local_tally_ = is_activated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetFixedPoint(bool const& is_activated)
+{
+  is_fixed_point_ = is_activated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetBatchUncertainty(bool const& is_activated)
+{
+  is_batch_uncertainty_ = is_activated;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -309,18 +361,119 @@ void GGEMSDosimetryCalculator::InitializeKernel(void)
   // Getting the path to kernel
   std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
   std::string compute_dose_filename = openCL_kernel_path + "/ComputeDoseGGEMSVoxelizedSolid.cl";
+  std::string accumulate_batch_filename = openCL_kernel_path + "/AccumulateBatchGGEMSVoxelizedSolid.cl";
 
   // Storing a kernel for each device
   kernel_compute_dose_ = new cl::Kernel*[number_activated_devices_];
 
+  // Labels of voxelized phantom on 16 bits if more than 255 materials
+  std::string kernel_option("");
+  if (navigator_->GetSolids(0)->GetLabelSize() == sizeof(GGushort)) kernel_option += " -DLABEL_16BIT";
+  if (is_fixed_point_) kernel_option += " -DDOSIMETRY_FIXED_POINT";
+
   // Compiling the kernels
-  opencl_manager.CompileKernel(compute_dose_filename, "compute_dose_ggems_voxelized_solid", kernel_compute_dose_, nullptr, nullptr);
+  opencl_manager.CompileKernel(compute_dose_filename, "compute_dose_ggems_voxelized_solid", kernel_compute_dose_, nullptr, const_cast<char*>(kernel_option.c_str()));
+
+  if (IsBatchUncertainty()) {
+    kernel_accumulate_batch_ = new cl::Kernel*[number_activated_devices_];
+    opencl_manager.CompileKernel(accumulate_batch_filename, "accumulate_batch_ggems_voxelized_solid", kernel_accumulate_batch_, nullptr, const_cast<char*>(kernel_option.c_str()));
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSDosimetryCalculator::ReduceTallies(void)
+{
+  GGcout("GGEMSDosimetryCalculator", "ReduceTallies", 3) << "Summing tallies of activated devices..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (is_fixed_point_) {
+    opencl_manager.ReduceBuffers<GGulong>(dose_recording_.edep_, total_number_of_dosels_*sizeof(GGulong));
+    if (dose_recording_.edep_squared_[0]) opencl_manager.ReduceBuffers<GGulong>(dose_recording_.edep_squared_, total_number_of_dosels_*sizeof(GGulong));
+  }
+  else {
+    opencl_manager.ReduceBuffers<GGDosiType>(dose_recording_.edep_, total_number_of_dosels_*sizeof(GGDosiType));
+    if (dose_recording_.edep_squared_[0]) opencl_manager.ReduceBuffers<GGDosiType>(dose_recording_.edep_squared_, total_number_of_dosels_*sizeof(GGDosiType));
+  }
+  if (dose_recording_.hit_[0]) opencl_manager.ReduceBuffers<GGint>(dose_recording_.hit_, total_number_of_dosels_*sizeof(GGint));
+  if (dose_recording_.photon_tracking_[0]) opencl_manager.ReduceBuffers<GGint>(dose_recording_.photon_tracking_, total_number_of_dosels_*sizeof(GGint));
+
+  // Batches of all devices are counted on first device
+  for (GGsize i = 1; i < number_activated_devices_; ++i) {
+    number_of_batches_[0] += number_of_batches_[i];
+    number_of_batches_[i] = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::ResetTallies(void)
+{
+  GGcout("GGEMSDosimetryCalculator", "ResetTallies", 3) << "Cleaning tallies of activated devices..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    opencl_manager.CleanBuffer(dose_recording_.edep_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.edep_squared_[j]) opencl_manager.CleanBuffer(dose_recording_.edep_squared_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.edep_batch_[j]) opencl_manager.CleanBuffer(dose_recording_.edep_batch_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.hit_[j]) opencl_manager.CleanBuffer(dose_recording_.hit_[j], total_number_of_dosels_*sizeof(GGint), j);
+    if (dose_recording_.photon_tracking_[j]) opencl_manager.CleanBuffer(dose_recording_.photon_tracking_[j], total_number_of_dosels_*sizeof(GGint), j);
+
+    number_of_batches_[j] = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::AccumulateBatch(GGsize const& thread_index)
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSDosimetryCalculator::AccumulateBatch in " << device_name << ", index " << device_index;
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(total_number_of_dosels_);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Getting kernel, and setting parameters
+  kernel_accumulate_batch_[thread_index]->setArg(0, total_number_of_dosels_);
+  kernel_accumulate_batch_[thread_index]->setArg(1, *dose_recording_.edep_batch_[thread_index]);
+  kernel_accumulate_batch_[thread_index]->setArg(2, *dose_recording_.edep_[thread_index]);
+  kernel_accumulate_batch_[thread_index]->setArg(3, *dose_recording_.edep_squared_[thread_index]);
+
+  // Launching kernel, queue is in-order so the kernel runs after tracking of the batch
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_accumulate_batch_[thread_index], 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSDosimetryCalculator", "AccumulateBatch");
+
+  ++number_of_batches_[thread_index];
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
 {
   // Getting the OpenCL manager and infos for work-item launching
@@ -366,6 +519,12 @@ void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
   kernel_compute_dose_[thread_index]->setArg(10, scale_factor_);
   kernel_compute_dose_[thread_index]->setArg(11, is_water_reference_);
   kernel_compute_dose_[thread_index]->setArg(12, minimum_density_);
+  kernel_compute_dose_[thread_index]->setArg(13, IsBatchUncertainty() ? number_of_batches_[thread_index] : 0);
+
+  // Uncertainty is 1 with less than 2 batches, and not reliable with few batches
+  if (IsBatchUncertainty() && number_of_batches_[thread_index] < MINIMUM_NUMBER_OF_BATCHES) {
+    GGwarn("GGEMSDosimetryCalculator", "ComputeDose", 0) << "Only " << number_of_batches_[thread_index] << " batch(es) simulated, uncertainty computed batch by batch is not reliable!!!" << GGendl;
+  }
 
   // Launching kernel
   cl::Event event;
@@ -452,22 +611,25 @@ void GGEMSDosimetryCalculator::Initialize(void)
     opencl_manager.ReleaseDeviceBuffer(dose_params_[j], dose_params_device, j);
 
     // Allocated buffers storing dose on OpenCL device
-    dose_recording_.edep_[j] = opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
-    dose_recording_.dose_[j] = opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
+    dose_recording_.edep_[j] = opencl_manager.Allocate(nullptr, total_number_of_dosels_*GetTallyTypeSize(), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
 
-    dose_recording_.uncertainty_dose_[j] = is_uncertainty_ ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
-    dose_recording_.edep_squared_[j] = (is_edep_squared_||is_uncertainty_) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
-    dose_recording_.hit_[j] = (is_hit_tracking_||is_uncertainty_) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    // Dose and uncertainty are computed once on first device from tallies of all devices
+    dose_recording_.dose_[j] = (j == 0) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.uncertainty_dose_[j] = (is_uncertainty_ && j == 0) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.edep_squared_[j] = (is_edep_squared_||is_uncertainty_) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*GetTallyTypeSize(), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.edep_batch_[j] = IsBatchUncertainty() ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*GetTallyTypeSize(), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.hit_[j] = (is_hit_tracking_||(is_uncertainty_ && !IsBatchUncertainty())) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
 
     dose_recording_.photon_tracking_[j] = is_photon_tracking_ ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
 
     // Set buffer to zero
-    opencl_manager.CleanBuffer(dose_recording_.edep_[j], total_number_of_dosels_*sizeof(GGDosiType), j);
-    opencl_manager.CleanBuffer(dose_recording_.dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
+    opencl_manager.CleanBuffer(dose_recording_.edep_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.dose_[j]) opencl_manager.CleanBuffer(dose_recording_.dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
 
-    if (is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.uncertainty_dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
-    if (is_edep_squared_||is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.edep_squared_[j], total_number_of_dosels_*sizeof(GGDosiType), j);
-    if (is_hit_tracking_||is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.hit_[j], total_number_of_dosels_*sizeof(GGint), j);
+    if (dose_recording_.uncertainty_dose_[j]) opencl_manager.CleanBuffer(dose_recording_.uncertainty_dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
+    if (is_edep_squared_||is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.edep_squared_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.edep_batch_[j]) opencl_manager.CleanBuffer(dose_recording_.edep_batch_[j], total_number_of_dosels_*GetTallyTypeSize(), j);
+    if (dose_recording_.hit_[j]) opencl_manager.CleanBuffer(dose_recording_.hit_[j], total_number_of_dosels_*sizeof(GGint), j);
 
     if (is_photon_tracking_) opencl_manager.CleanBuffer(dose_recording_.photon_tracking_[j], total_number_of_dosels_*sizeof(GGint), j);
   }
@@ -519,13 +681,10 @@ void GGEMSDosimetryCalculator::SavePhotonTracking(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGint* photon_tracking_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.photon_tracking_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGint), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) photon_tracking[i] += photon_tracking_device[i];
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.photon_tracking_[j], photon_tracking_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  GGint* photon_tracking_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.photon_tracking_[0], CL_TRUE, CL_MAP_READ, total_number_of_dosels*sizeof(GGint), 0);
+  std::copy(photon_tracking_device, photon_tracking_device + total_number_of_dosels, photon_tracking);
+  opencl_manager.ReleaseDeviceBuffer(dose_recording_.photon_tracking_[0], photon_tracking_device, 0);
 
   // Writing data
   mhdImage.Write<GGint>(photon_tracking);
@@ -562,14 +721,10 @@ void GGEMSDosimetryCalculator::SaveHit(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGint* hit_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.hit_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGint), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) hit_tracking[i] = hit_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.hit_[j], hit_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  GGint* hit_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.hit_[0], CL_TRUE, CL_MAP_READ, total_number_of_dosels*sizeof(GGint), 0);
+  std::copy(hit_device, hit_device + total_number_of_dosels, hit_tracking);
+  opencl_manager.ReleaseDeviceBuffer(dose_recording_.hit_[0], hit_device, 0);
 
   // Writing data
   mhdImage.Write<GGint>(hit_tracking);
@@ -607,14 +762,8 @@ void GGEMSDosimetryCalculator::SaveEdep(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.edep_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) edep_tracking[i] = edep_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.edep_[j], edep_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  ReadTally(dose_recording_.edep_[0], edep_tracking, total_number_of_dosels, DOSIMETRY_FIXED_POINT_SCALE);
 
   // Writing data
   mhdImage.Write<GGDosiType>(edep_tracking);
@@ -652,14 +801,8 @@ void GGEMSDosimetryCalculator::SaveEdepSquared(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_squared_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.edep_squared_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) edep_squared_tracking[i] = edep_squared_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.edep_squared_[j], edep_squared_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  ReadTally(dose_recording_.edep_squared_[0], edep_squared_tracking, total_number_of_dosels, DOSIMETRY_FIXED_POINT_SQUARED_SCALE);
 
   // Writing data
   mhdImage.Write<GGDosiType>(edep_squared_tracking);
@@ -667,6 +810,29 @@ void GGEMSDosimetryCalculator::SaveEdepSquared(void) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::ReadTally(cl::Buffer* tally, GGDosiType* tally_host, GGsize const& number_of_dosels, GGfloat const& fixed_point_scale) const
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (is_fixed_point_) {
+    GGulong* tally_device = opencl_manager.GetDeviceBuffer<GGulong>(tally, CL_TRUE, CL_MAP_READ, number_of_dosels*sizeof(GGulong), 0);
+    for (GGsize i = 0; i < number_of_dosels; ++i) {
+      tally_host[i] = static_cast<GGDosiType>(tally_device[i]) / static_cast<GGDosiType>(fixed_point_scale);
+    }
+    opencl_manager.ReleaseDeviceBuffer(tally, tally_device, 0);
+  }
+  else {
+    GGDosiType* tally_device = opencl_manager.GetDeviceBuffer<GGDosiType>(tally, CL_TRUE, CL_MAP_READ, number_of_dosels*sizeof(GGDosiType), 0);
+    std::copy(tally_device, tally_device + number_of_dosels, tally_host);
+    opencl_manager.ReleaseDeviceBuffer(tally, tally_device, 0);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -696,14 +862,10 @@ void GGEMSDosimetryCalculator::SaveDose(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGfloat* dose_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.dose_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) dose[i] += dose_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.dose_[j], dose_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  GGfloat* dose_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.dose_[0], CL_TRUE, CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), 0);
+  std::copy(dose_device, dose_device + total_number_of_dosels, dose);
+  opencl_manager.ReleaseDeviceBuffer(dose_recording_.dose_[0], dose_device, 0);
 
   // Writing data
   mhdImage.Write<GGfloat>(dose);
@@ -740,14 +902,10 @@ void GGEMSDosimetryCalculator::SaveUncertainty(void) const
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGfloat* uncertainty_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.uncertainty_dose_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) uncertainty[i] = uncertainty_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.uncertainty_dose_[j], uncertainty_device, j);
-  }
+  // Tallies of all devices are reduced on first device
+  GGfloat* uncertainty_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.uncertainty_dose_[0], CL_TRUE, CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), 0);
+  std::copy(uncertainty_device, uncertainty_device + total_number_of_dosels, uncertainty);
+  opencl_manager.ReleaseDeviceBuffer(dose_recording_.uncertainty_dose_[0], uncertainty_device, 0);
 
   // Writing data
   mhdImage.Write<GGfloat>(uncertainty);
@@ -860,6 +1018,33 @@ void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void dose_local_tally_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetLocalTally(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void dose_fixed_point_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetFixedPoint(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void dose_batch_uncertainty_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetBatchUncertainty(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void water_reference_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
 {
   dose_calculator->SetWaterReference(is_activated);
@@ -325,14 +325,6 @@ void GGEMSNavigator::ParticleSolidDistance(GGsize const& thread_index)
   cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
   GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
 
-  // Getting work group size, and work-item number
-  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
-  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
-
-  // Parameters for work-item in kernel
-  cl::NDRange global_wi(number_of_work_items);
-  cl::NDRange local_wi(work_group_size);
-
   // Loop over all the solids
   for (GGsize i = 0; i < number_of_solids_; ++i) {
     // Getting solid data infos
@@ -344,11 +336,19 @@ void GGEMSNavigator::ParticleSolidDistance(GGsize const& thread_index)
     kernel->setArg(1, *primary_particles);
     kernel->setArg(2, *solid_data);
 
+    // Getting work group size of kernel, and work-item number
+    GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel);
+    GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
+
+    // Parameters for work-item in kernel
+    cl::NDRange global_wi(number_of_work_items);
+    cl::NDRange local_wi(work_group_size);
+
     // Launching kernel
     cl::Event event;
     GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
     opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "ParticleSolidDistance");
-    queue->finish();
+    opencl_manager.TuneKernelWorkGroupSize(kernel, event, number_of_work_items);
 
     // GGEMS Profiling
     GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
@@ -376,14 +376,6 @@ void GGEMSNavigator::ProjectToSolid(GGsize const& thread_index)
   cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
   GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
 
-  // Getting work group size, and work-item number
-  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
-  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
-
-  // Parameters for work-item in kernel
-  cl::NDRange global_wi(number_of_work_items);
-  cl::NDRange local_wi(work_group_size);
-
   // Loop over all the solids
   for (GGsize i = 0; i < number_of_solids_; ++i) {
     // Getting solid data infos
@@ -395,11 +387,19 @@ void GGEMSNavigator::ProjectToSolid(GGsize const& thread_index)
     kernel->setArg(1, *primary_particles);
     kernel->setArg(2, *solid_data);
 
+    // Getting work group size of kernel, and work-item number
+    GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel);
+    GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
+
+    // Parameters for work-item in kernel
+    cl::NDRange global_wi(number_of_work_items);
+    cl::NDRange local_wi(work_group_size);
+
     // Launching kernel
     cl::Event event;
     GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
     opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "ProjectToSolid");
-    queue->finish();
+    opencl_manager.TuneKernelWorkGroupSize(kernel, event, number_of_work_items);
 
     // GGEMS Profiling
     GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
@@ -439,14 +439,6 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
   // Geetning OpenCL buffer for attenuations
   cl::Buffer* attenuations = attenuations_->GetAttenuations(thread_index);
 
-  // Getting work group size, and work-item number
-  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
-  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
-
-  // Parameters for work-item in kernel
-  cl::NDRange global_wi(number_of_work_items);
-  cl::NDRange local_wi(work_group_size);
-
   // Loop over all the solids
   for (GGsize i = 0; i < number_of_solids_; ++i) {
     // Getting solid  and label (for GGEMSVoxelizedSolid) data infos
@@ -475,8 +467,14 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
       dosimetry_params = dose_calculator_->GetDoseParams(thread_index);
       photon_tracking_dosimetry = dose_calculator_->GetPhotonTrackingBuffer(thread_index);
       hit_tracking_dosimetry = dose_calculator_->GetHitTrackingBuffer(thread_index);
-      edep_tracking_dosimetry = dose_calculator_->GetEdepBuffer(thread_index);
-      edep_squared_tracking_dosimetry = dose_calculator_->GetEdepSquaredBuffer(thread_index);
+      // In batch uncertainty mode, energy deposit of the batch is recorded without its square
+      if (dose_calculator_->IsBatchUncertainty()) {
+        edep_tracking_dosimetry = dose_calculator_->GetEdepBatchBuffer(thread_index);
+      }
+      else {
+        edep_tracking_dosimetry = dose_calculator_->GetEdepBuffer(thread_index);
+        edep_squared_tracking_dosimetry = dose_calculator_->GetEdepSquaredBuffer(thread_index);
+      }
     }
 
     // Getting kernel, and setting parameters
@@ -509,14 +507,22 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
       else kernel->setArg(13, *photon_tracking_dosimetry);
     }
 
+    // Getting work group size of kernel, and work-item number
+    GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel);
+    GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
+
+    // Parameters for work-item in kernel
+    cl::NDRange global_wi(number_of_work_items);
+    cl::NDRange local_wi(work_group_size);
+
     // Launching kernel
     cl::Event event;
     GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
     opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "TrackThroughSolid");
+    opencl_manager.TuneKernelWorkGroupSize(kernel, event, number_of_work_items);
 
     // GGEMS Profiling
     GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
-    queue->finish();
   }
 }
 
@@ -524,9 +530,40 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSNavigator::ComputeDose(GGsize const& thread_index)
+void GGEMSNavigator::AccumulateBatch(GGsize const& thread_index)
+{
+  if (is_dosimetry_mode_ && dose_calculator_->IsBatchUncertainty()) dose_calculator_->AccumulateBatch(thread_index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSNavigator::GetMinimumNumberOfBatchs(void) const
+{
+  return (is_dosimetry_mode_ && dose_calculator_->IsBatchUncertainty()) ? MINIMUM_NUMBER_OF_BATCHES : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigator::ComputeDose(void)
+{
+  if (is_dosimetry_mode_) {
+    dose_calculator_->ReduceTallies();
+    dose_calculator_->ComputeDose(0);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigator::ResetTallies(void)
 {
-  if (is_dosimetry_mode_) dose_calculator_->ComputeDose(thread_index);
+  if (is_dosimetry_mode_) dose_calculator_->ResetTallies();
+  ResetProjection();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -131,6 +131,20 @@ void GGEMSNavigatorManager::SaveResults(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSNavigatorManager::SaveSweepResults(void) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->SaveSweepResults();
+  }
+
+  // Checking if world exists
+  if (world_) world_->SaveResults();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigatorManager::Initialize(bool const& is_tracking) const
 {
   GGcout("GGEMSNavigatorManager", "Initialize", 3) << "Initializing the GGEMS navigator(s)..." << GGendl;
@@ -215,9 +229,84 @@ void GGEMSNavigatorManager::WorldTracking(GGsize const& thread_index) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSNavigatorManager::ComputeDose(GGsize const& thread_index)
+void GGEMSNavigatorManager::AccumulateBatch(GGsize const& thread_index) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->AccumulateBatch(thread_index);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSNavigatorManager::GetMinimumNumberOfBatchs(void) const
+{
+  GGsize minimum_number_of_batchs = 1;
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    GGsize navigator_minimum_number_of_batchs = navigators_[i]->GetMinimumNumberOfBatchs();
+    if (navigator_minimum_number_of_batchs > minimum_number_of_batchs) minimum_number_of_batchs = navigator_minimum_number_of_batchs;
+  }
+  return minimum_number_of_batchs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::ComputeDose(void)
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->ComputeDose();
+  }
+
+  // Summing world tallies of all devices
+  if (world_) world_->ReduceTallies();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::ResetTallies(void) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->ResetTallies();
+  }
+
+  // Checking if world exists
+  if (world_) world_->ResetTallies();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::RotateGantry(GGfloat const& angle) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->RotateGantry(angle);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::ResetProjection(void) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->ResetProjection();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::SaveProjection(GGsize const& projection_index) const
 {
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
-    navigators_[i]->ComputeDose(thread_index);
+    navigators_[i]->SaveProjection(projection_index);
   }
 }
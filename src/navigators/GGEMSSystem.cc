@@ -27,16 +27,31 @@
   \date Monday October 19, 2020
 */
 
+#include <iomanip>
+
 #include "GGEMS/navigators/GGEMSSystem.hh"
 #include "GGEMS/geometries/GGEMSSolid.hh"
+#include "GGEMS/geometries/GGEMSSolidBoxData.hh"
 #include "GGEMS/io/GGEMSMHDImage.hh"
+#include "GGEMS/physics/GGEMSCrossSections.hh"
+#include "GGEMS/materials/GGEMSMaterials.hh"
+#include "GGEMS/sources/GGEMSSourceManager.hh"
+#include "GGEMS/randoms/GGEMSPseudoRandomGenerator.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 GGEMSSystem::GGEMSSystem(std::string const& system_name)
-: GGEMSNavigator(system_name)
+: GGEMSNavigator(system_name),
+  is_solid_table_(false),
+  solid_table_(nullptr),
+  histogram_table_(nullptr),
+  scatter_table_(nullptr),
+  kernel_particle_solid_distance_table_(nullptr),
+  kernel_project_to_solid_table_(nullptr),
+  kernel_track_through_solid_table_(nullptr)
 {
   GGcout("GGEMSSystem", "GGEMSSystem", 3) << "GGEMSSystem creating..." << GGendl;
 
@@ -68,6 +83,49 @@ GGEMSSystem::~GGEMSSystem(void)
 {
   GGcout("GGEMSSystem", "~GGEMSSystem", 3) << "GGEMSSystem erasing..." << GGendl;
 
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGsize number_of_elements = number_of_solids_*number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*number_of_detection_elements_inside_module_xyz_.z_;
+
+  if (solid_table_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(solid_table_[i], number_of_solids_*sizeof(GGEMSSolidBoxData), i);
+    }
+    delete[] solid_table_;
+    solid_table_ = nullptr;
+  }
+
+  if (histogram_table_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(histogram_table_[i], number_of_elements*sizeof(GGint), i);
+    }
+    delete[] histogram_table_;
+    histogram_table_ = nullptr;
+  }
+
+  if (scatter_table_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      if (scatter_table_[i]) opencl_manager.Deallocate(scatter_table_[i], number_of_elements*sizeof(GGint), i);
+    }
+    delete[] scatter_table_;
+    scatter_table_ = nullptr;
+  }
+
+  if (kernel_particle_solid_distance_table_) {
+    delete[] kernel_particle_solid_distance_table_;
+    kernel_particle_solid_distance_table_ = nullptr;
+  }
+
+  if (kernel_project_to_solid_table_) {
+    delete[] kernel_project_to_solid_table_;
+    kernel_project_to_solid_table_ = nullptr;
+  }
+
+  if (kernel_track_through_solid_table_) {
+    delete[] kernel_track_through_solid_table_;
+    kernel_track_through_solid_table_ = nullptr;
+  }
+
   GGcout("GGEMSSystem", "~GGEMSSystem", 3) << "GGEMSSystem erased!!!" << GGendl;
 }
 
@@ -136,6 +194,15 @@ void GGEMSSystem::StoreScatter(bool const& is_scatter)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSystem::EnableSolidTable(bool const& is_solid_table)
+{
+  is_solid_table_ = is_solid_table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSystem::CheckParameters(void) const
 {
   GGcout("GGEMSSystem", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
@@ -171,45 +238,351 @@ void GGEMSSystem::CheckParameters(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSSystem::SaveResults(void)
+void GGEMSSystem::InitializeSolidTable(void)
 {
-  GGcout("GGEMSSystem", "SaveResults", 2) << "Saving results in MHD format..." << GGendl;
+  GGcout("GGEMSSystem", "InitializeSolidTable", 3) << "Initializing table of solids..." << GGendl;
 
-  GGsize3 total_dim;
-  total_dim.x_ = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
-  total_dim.y_ = number_of_modules_xy_.y_*number_of_detection_elements_inside_module_xyz_.y_;
-  total_dim.z_ = number_of_detection_elements_inside_module_xyz_.z_;
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Histograms of all the modules are stored one after the other
+  GGsize number_of_elements = number_of_solids_*number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*number_of_detection_elements_inside_module_xyz_.z_;
+
+  solid_table_ = new cl::Buffer*[number_activated_devices_];
+  histogram_table_ = new cl::Buffer*[number_activated_devices_];
+  scatter_table_ = new cl::Buffer*[number_activated_devices_];
+
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    solid_table_[d] = opencl_manager.Allocate(nullptr, number_of_solids_*sizeof(GGEMSSolidBoxData), d, CL_MEM_READ_WRITE, "GGEMSSystem");
+    UpdateSolidTable(d);
+
+    histogram_table_[d] = opencl_manager.Allocate(nullptr, number_of_elements*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSystem");
+    opencl_manager.CleanBuffer(histogram_table_[d], number_of_elements*sizeof(GGint), d);
+
+    scatter_table_[d] = nullptr;
+    if (is_scatter_) {
+      scatter_table_[d] = opencl_manager.Allocate(nullptr, number_of_elements*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSystem");
+      opencl_manager.CleanBuffer(scatter_table_[d], number_of_elements*sizeof(GGint), d);
+    }
+  }
+
+  // Compiling the kernels
+  kernel_particle_solid_distance_table_ = new cl::Kernel*[number_activated_devices_];
+  kernel_project_to_solid_table_ = new cl::Kernel*[number_activated_devices_];
+  kernel_track_through_solid_table_ = new cl::Kernel*[number_activated_devices_];
+
+  // All modules share the same options (histogram, tracking...), the table kernels are compiled with them
+  std::string kernel_option = solids_[0]->GetKernelOption();
+
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string particle_solid_distance_filename = openCL_kernel_path + "/ParticleSolidDistanceGGEMSSolidBoxTable.cl";
+  std::string project_to_filename = openCL_kernel_path + "/ProjectToGGEMSSolidBoxTable.cl";
+  std::string track_through_filename = openCL_kernel_path + "/TrackThroughGGEMSSolidBoxTable.cl";
+
+  opencl_manager.CompileKernel(particle_solid_distance_filename, "particle_solid_distance_ggems_solid_box_table", kernel_particle_solid_distance_table_, nullptr, const_cast<char*>(kernel_option.c_str()));
+  opencl_manager.CompileKernel(project_to_filename, "project_to_ggems_solid_box_table", kernel_project_to_solid_table_, nullptr, const_cast<char*>(kernel_option.c_str()));
+  opencl_manager.CompileKernel(track_through_filename, "track_through_ggems_solid_box_table", kernel_track_through_solid_table_, nullptr, const_cast<char*>(kernel_option.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSystem::UpdateSolidTable(GGsize const& thread_index)
+{
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  GGint* output = new GGint[total_dim.x_*total_dim.y_*total_dim.z_];
-  std::memset(output, 0, total_dim.x_*total_dim.y_*total_dim.z_*sizeof(GGint));
 
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(output_basename_);
-  mhdImage.SetDataType("MET_INT");
-  mhdImage.SetDimensions(total_dim);
-  mhdImage.SetElementSizes(size_of_detection_elements_xyz_);
+  GGEMSSolidBoxData* solid_table_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_table_[thread_index], CL_TRUE, CL_MAP_WRITE, number_of_solids_*sizeof(GGEMSSolidBoxData), thread_index);
+
+  // Copying data of each module, solid ids are consecutive in table
+  for (GGsize i = 0; i < number_of_solids_; ++i) {
+    cl::Buffer* solid_data = solids_[i]->GetSolidData(thread_index);
+    GGEMSSolidBoxData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_data, CL_TRUE, CL_MAP_READ, sizeof(GGEMSSolidBoxData), thread_index);
+
+    solid_table_device[i] = *solid_data_device;
+
+    opencl_manager.ReleaseDeviceBuffer(solid_data, solid_data_device, thread_index);
+  }
+
+  opencl_manager.ReleaseDeviceBuffer(solid_table_[thread_index], solid_table_device, thread_index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::ParticleSolidDistance(GGsize const& thread_index)
+{
+  if (!is_solid_table_) {
+    GGEMSNavigator::ParticleSolidDistance(thread_index);
+    return;
+  }
+
+  cl::Kernel* kernel = kernel_particle_solid_distance_table_[thread_index];
+  kernel->setArg(2, *solid_table_[thread_index]);
+  kernel->setArg(3, static_cast<GGint>(number_of_solids_));
+
+  LaunchSolidTableKernel(kernel, thread_index, "ParticleSolidDistance");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::LaunchSolidTableKernel(cl::Kernel* kernel, GGsize const& thread_index, std::string const& method_name) const
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSSystem::" << method_name << " on " << device_name << ", index " << device_index;
+
+  // Pointer to primary particles, and number to particles in buffer
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
+  GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
+
+  // Getting work group size of kernel, and work-item number
+  GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel);
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Particle arguments are the same for all table kernels
+  kernel->setArg(0, number_of_particles);
+  kernel->setArg(1, *primary_particles);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSSystem", method_name);
+  opencl_manager.TuneKernelWorkGroupSize(kernel, event, number_of_work_items);
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::RotateGantry(GGfloat const& angle)
+{
+  GGfloat3 rotation;
+  rotation.s[0] = 0.0f;
+  rotation.s[1] = 0.0f;
+  rotation.s[2] = angle;
+
+  // Rotation is composed with the current transformation of each module, so positions rotate around isocenter
+  for (GGsize i = 0; i < number_of_solids_; ++i) {
+    solids_[i]->SetRotation(rotation);
+    for (GGsize j = 0; j < number_activated_devices_; ++j) solids_[i]->UpdateTransformationMatrix(j);
+  }
+
+  // Copying new transformation matrices in table of solids
+  if (is_solid_table_) {
+    for (GGsize j = 0; j < number_activated_devices_; ++j) UpdateSolidTable(j);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::ResetProjection(void)
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGsize module_elements = number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*number_of_detection_elements_inside_module_xyz_.z_;
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    if (is_solid_table_) {
+      opencl_manager.CleanBuffer(histogram_table_[j], number_of_solids_*module_elements*sizeof(GGint), j);
+      if (scatter_table_[j]) opencl_manager.CleanBuffer(scatter_table_[j], number_of_solids_*module_elements*sizeof(GGint), j);
+    }
+    else {
+      for (GGsize i = 0; i < number_of_solids_; ++i) {
+        opencl_manager.CleanBuffer(solids_[i]->GetHistogram(j), module_elements*sizeof(GGint), j);
+        if (is_scatter_) opencl_manager.CleanBuffer(solids_[i]->GetScatterHistogram(j), module_elements*sizeof(GGint), j);
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::ProjectToSolid(GGsize const& thread_index)
+{
+  if (!is_solid_table_) {
+    GGEMSNavigator::ProjectToSolid(thread_index);
+    return;
+  }
+
+  cl::Kernel* kernel = kernel_project_to_solid_table_[thread_index];
+  kernel->setArg(2, *solid_table_[thread_index]);
+  kernel->setArg(3, static_cast<GGint>(number_of_solids_));
+
+  LaunchSolidTableKernel(kernel, thread_index, "ProjectToSolid");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::TrackThroughSolid(GGsize const& thread_index)
+{
+  if (!is_solid_table_) {
+    GGEMSNavigator::TrackThroughSolid(thread_index);
+    return;
+  }
+
+  // Getting OpenCL pointer to random number
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  cl::Buffer* randoms = source_manager.GetPseudoRandomGenerator()->GetPseudoRandomNumbers(thread_index);
+
+  // Getting OpenCL buffer for cross section, materials and attenuations
+  cl::Buffer* cross_sections = cross_sections_->GetCrossSections(thread_index);
+  cl::Buffer* materials = materials_->GetMaterialTables(thread_index);
+  cl::Buffer* attenuations = attenuations_->GetAttenuations(thread_index);
+
+  cl::Kernel* kernel = kernel_track_through_solid_table_[thread_index];
+  kernel->setArg(2, *randoms);
+  kernel->setArg(3, *solid_table_[thread_index]);
+  kernel->setArg(4, static_cast<GGint>(number_of_solids_));
+  kernel->setArg(5, sizeof(cl_mem), nullptr); // No label in solid box
+  kernel->setArg(6, *cross_sections);
+  kernel->setArg(7, *materials);
+  kernel->setArg(8, *attenuations);
+  kernel->setArg(9, threshold_);
+  kernel->setArg(10, *histogram_table_[thread_index]);
+  if (!scatter_table_[thread_index]) kernel->setArg(11, sizeof(cl_mem), nullptr);
+  else kernel->setArg(11, *scatter_table_[thread_index]);
+
+  LaunchSolidTableKernel(kernel, thread_index, "TrackThroughSolid");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::AccumulateHistogram(GGint* output, bool const& is_scatter) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGsize total_dim_x = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
+  GGsize module_elements = number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*number_of_detection_elements_inside_module_xyz_.z_;
 
   // Getting all the counts from solid from all OpenCL devices
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    // In solid table mode, histograms of all modules are in the same buffer
+    cl::Buffer* table = nullptr;
+    GGint* table_device = nullptr;
+    if (is_solid_table_) {
+      table = is_scatter ? scatter_table_[i] : histogram_table_[i];
+      table_device = opencl_manager.GetDeviceBuffer<GGint>(table, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_solids_*module_elements*sizeof(GGint), i);
+    }
+
     for (GGsize jj = 0; jj < number_of_modules_xy_.y_; ++jj) {
       for (GGsize ii = 0; ii < number_of_modules_xy_.x_; ++ii) {
-        cl::Buffer* histogram = solids_[ii + jj* number_of_modules_xy_.x_]->GetHistogram(i);
+        GGsize module_index = ii + jj*number_of_modules_xy_.x_;
 
-        GGint* histogram_device = opencl_manager.GetDeviceBuffer<GGint>(histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*sizeof(GGint), i);
+        cl::Buffer* histogram = nullptr;
+        GGint* histogram_device = nullptr;
+        if (is_solid_table_) {
+          histogram_device = table_device + module_index*module_elements;
+        }
+        else {
+          histogram = is_scatter ? solids_[module_index]->GetScatterHistogram(i) : solids_[module_index]->GetHistogram(i);
+          histogram_device = opencl_manager.GetDeviceBuffer<GGint>(histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*sizeof(GGint), i);
+        }
 
         // Storing data on host
         for (GGsize jjj = 0; jjj < number_of_detection_elements_inside_module_xyz_.y_; ++jjj) {
           for (GGsize iii = 0; iii < number_of_detection_elements_inside_module_xyz_.x_; ++iii) {
-            output[(iii+ii*number_of_detection_elements_inside_module_xyz_.x_) + (jjj+jj*number_of_detection_elements_inside_module_xyz_.y_)*total_dim.x_] +=
+            output[(iii+ii*number_of_detection_elements_inside_module_xyz_.x_) + (jjj+jj*number_of_detection_elements_inside_module_xyz_.y_)*total_dim_x] +=
               histogram_device[iii + jjj*number_of_detection_elements_inside_module_xyz_.x_];
           }
         }
 
-        opencl_manager.ReleaseDeviceBuffer(histogram, histogram_device, i);
+        if (!is_solid_table_) opencl_manager.ReleaseDeviceBuffer(histogram, histogram_device, i);
       }
     }
+
+    if (is_solid_table_) opencl_manager.ReleaseDeviceBuffer(table, table_device, i);
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SaveResults(void)
+{
+  SaveHistograms(output_basename_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SaveProjection(GGsize const& projection_index)
+{
+  // Index of projection is added between end of filename and suffix
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "-" << std::setfill('0') << std::setw(4) << projection_index;
+
+  std::string projection_output_filename = output_basename_;
+  GGsize found_mhd = output_basename_.find(".mhd");
+  if (found_mhd == std::string::npos) {
+    projection_output_filename += oss.str() + ".mhd";
+  }
+  else {
+    projection_output_filename = projection_output_filename.substr(0, found_mhd) + oss.str() + ".mhd";
+  }
+
+  SaveHistograms(projection_output_filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SaveSweepResults(void)
+{
+  // Histograms of last projection are already saved with its index, unsuffixed output would duplicate it
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SaveHistograms(std::string const& output_basename) const
+{
+  GGcout("GGEMSSystem", "SaveHistograms", 2) << "Saving results in MHD format..." << GGendl;
+
+  GGsize3 total_dim;
+  total_dim.x_ = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
+  total_dim.y_ = number_of_modules_xy_.y_*number_of_detection_elements_inside_module_xyz_.y_;
+  total_dim.z_ = number_of_detection_elements_inside_module_xyz_.z_;
+
+  GGint* output = new GGint[total_dim.x_*total_dim.y_*total_dim.z_];
+  std::memset(output, 0, total_dim.x_*total_dim.y_*total_dim.z_*sizeof(GGint));
+
+  GGEMSMHDImage mhdImage;
+  mhdImage.SetOutputFileName(output_basename);
+  mhdImage.SetDataType("MET_INT");
+  mhdImage.SetDimensions(total_dim);
+  mhdImage.SetElementSizes(size_of_detection_elements_xyz_);
+
+  // Getting all the counts from solid from all OpenCL devices
+  AccumulateHistogram(output, false);
 
   mhdImage.Write<GGint>(output);
 
@@ -219,10 +592,10 @@ void GGEMSSystem::SaveResults(void)
   // If scatter output if necessary
   if (is_scatter_) {
     // From output file add '-scatter' extension
-    std::string scatter_output_filename = output_basename_;
+    std::string scatter_output_filename = output_basename;
 
     // Checking if there is .mhd suffix
-    GGsize found_mhd = output_basename_.find(".mhd");
+    GGsize found_mhd = output_basename.find(".mhd");
 
     if (found_mhd == std::string::npos) { // "add '-scatter.mhd' at the end of file"
       scatter_output_filename += "-scatter.mhd";
@@ -238,25 +611,7 @@ void GGEMSSystem::SaveResults(void)
     mhdImageScatter.SetElementSizes(size_of_detection_elements_xyz_);
 
     // Getting all the counts from solid from all OpenCL devices
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      for (GGsize jj = 0; jj < number_of_modules_xy_.y_; ++jj) {
-        for (GGsize ii = 0; ii < number_of_modules_xy_.x_; ++ii) {
-          cl::Buffer* scatter_histogram = solids_[ii + jj* number_of_modules_xy_.x_]->GetScatterHistogram(i);
-
-          GGint* scatter_histogram_device = opencl_manager.GetDeviceBuffer<GGint>(scatter_histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*sizeof(GGint), i);
-
-          // Storing data on host
-          for (GGsize jjj = 0; jjj < number_of_detection_elements_inside_module_xyz_.y_; ++jjj) {
-            for (GGsize iii = 0; iii < number_of_detection_elements_inside_module_xyz_.x_; ++iii) {
-              output[(iii+ii*number_of_detection_elements_inside_module_xyz_.x_) + (jjj+jj*number_of_detection_elements_inside_module_xyz_.y_)*total_dim.x_] +=
-                scatter_histogram_device[iii + jjj*number_of_detection_elements_inside_module_xyz_.x_];
-            }
-          }
-
-          opencl_manager.ReleaseDeviceBuffer(scatter_histogram, scatter_histogram_device, i);
-        }
-      }
-    }
+    AccumulateHistogram(output, true);
 
     mhdImageScatter.Write<GGint>(output);
   }
@@ -40,7 +40,8 @@
 GGEMSVoxelizedPhantom::GGEMSVoxelizedPhantom(std::string const& voxelized_phantom_name)
 : GGEMSNavigator(voxelized_phantom_name),
   voxelized_phantom_filename_(""),
-  range_data_filename_("")
+  range_data_filename_(""),
+  is_woodcock_(false)
 {
   GGcout("GGEMSVoxelizedPhantom", "GGEMSVoxelizedPhantom", 3) << "GGEMSVoxelizedPhantom creating..." << GGendl;
 
@@ -79,6 +80,20 @@ void GGEMSVoxelizedPhantom::CheckParameters(void) const
     oss << "You have to set a file with the range to material data!!!";
     GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
   }
+
+  // Woodcock tracking does not step through voxels, TLE needs voxel track lengths
+  if (is_woodcock_ && is_tle_) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Woodcock tracking and TLE dosimetry can not be used together!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
+  }
+
+  // Woodcock tracking does not cross voxel boundaries, photon tracking map would stay empty
+  if (is_woodcock_ && is_dosimetry_mode_ && dose_calculator_->IsPhotonTracking()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Woodcock tracking and photon tracking dosimetry can not be used together!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +130,15 @@ void GGEMSVoxelizedPhantom::Initialize(void)
   // Enabling TLE
   if (is_tle_) solids_[0]->AddKernelOption(" -DTLE");
 
+  // Enabling Woodcock tracking
+  if (is_woodcock_) solids_[0]->AddKernelOption(" -DWOODCOCK");
+
+  // Enabling dose accumulation in local memory
+  if (is_dosimetry_mode_ && dose_calculator_->IsLocalTally()) solids_[0]->AddKernelOption(" -DDOSE_LOCAL_TALLY");
+
+  // Enabling energy deposit accumulated in fixed-point unit
+  if (is_dosimetry_mode_ && dose_calculator_->IsFixedPoint()) solids_[0]->AddKernelOption(" -DDOSIMETRY_FIXED_POINT");
+
   // Load voxelized phantom from MHD file and storing materials
   solids_[0]->Initialize(materials_);
   solids_[0]->SetCustomMaterialColor(custom_material_rgb_);
@@ -177,6 +201,15 @@ void GGEMSVoxelizedPhantom::SetPhantomFile(std::string const& voxelized_phantom_
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSVoxelizedPhantom::SetWoodcockTracking(bool const& is_woodcock)
+{
+  is_woodcock_ = is_woodcock;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 GGEMSVoxelizedPhantom* create_ggems_voxelized_phantom(char const* voxelized_phantom_name)
 {
   return new(std::nothrow) GGEMSVoxelizedPhantom(voxelized_phantom_name);
@@ -244,3 +277,12 @@ void set_material_color_name_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxe
 {
   voxelized_phantom->SetMaterialColor(material_name, color_name);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_woodcock_tracking_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, bool const flag)
+{
+  voxelized_phantom->SetWoodcockTracking(flag);
+}
@@ -331,9 +331,9 @@ void GGEMSWorld::Tracking(GGsize const& thread_index)
   cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
   GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
 
-  // Getting work group size, and work-item number
-  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
-  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
+  // Getting work group size of kernel, and work-item number
+  GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel_world_tracking_[thread_index]);
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
 
   // Parameters for work-item in kernel
   cl::NDRange global_wi(number_of_work_items);
@@ -375,10 +375,54 @@ void GGEMSWorld::Tracking(GGsize const& thread_index)
   cl::Event event;
   GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_world_tracking_[thread_index], 0, global_wi, local_wi, nullptr, &event);
   opencl_manager.CheckOpenCLError(kernel_status, "GGEMSWorld", "Tracking");
+  opencl_manager.TuneKernelWorkGroupSize(kernel_world_tracking_[thread_index], event, number_of_work_items);
 
   // GGEMS Profiling
   GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
-  queue->finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSWorld::ResetTallies(void) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGsize total_number_voxel_world = dimensions_.x_ * dimensions_.y_ * dimensions_.z_;
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    if (is_photon_tracking_) opencl_manager.CleanBuffer(world_recording_.photon_tracking_[j], total_number_voxel_world*sizeof(GGint), j);
+    if (is_energy_tracking_) opencl_manager.CleanBuffer(world_recording_.energy_tracking_[j], total_number_voxel_world*sizeof(GGDosiType), j);
+    if (is_energy_squared_tracking_) opencl_manager.CleanBuffer(world_recording_.energy_squared_tracking_[j], total_number_voxel_world*sizeof(GGDosiType), j);
+    if (is_momentum_) {
+      opencl_manager.CleanBuffer(world_recording_.momentum_x_[j], total_number_voxel_world*sizeof(GGDosiType), j);
+      opencl_manager.CleanBuffer(world_recording_.momentum_y_[j], total_number_voxel_world*sizeof(GGDosiType), j);
+      opencl_manager.CleanBuffer(world_recording_.momentum_z_[j], total_number_voxel_world*sizeof(GGDosiType), j);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSWorld::ReduceTallies(void)
+{
+  GGcout("GGEMSWorld", "ReduceTallies", 3) << "Summing world tallies of activated devices..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGsize total_number_of_voxels = dimensions_.x_ * dimensions_.y_ * dimensions_.z_;
+
+  if (is_photon_tracking_) opencl_manager.ReduceBuffers<GGint>(world_recording_.photon_tracking_, total_number_of_voxels*sizeof(GGint));
+  if (is_energy_tracking_) opencl_manager.ReduceBuffers<GGDosiType>(world_recording_.energy_tracking_, total_number_of_voxels*sizeof(GGDosiType));
+  if (is_energy_squared_tracking_) opencl_manager.ReduceBuffers<GGDosiType>(world_recording_.energy_squared_tracking_, total_number_of_voxels*sizeof(GGDosiType));
+  if (is_momentum_) {
+    opencl_manager.ReduceBuffers<GGDosiType>(world_recording_.momentum_x_, total_number_of_voxels*sizeof(GGDosiType));
+    opencl_manager.ReduceBuffers<GGDosiType>(world_recording_.momentum_y_, total_number_of_voxels*sizeof(GGDosiType));
+    opencl_manager.ReduceBuffers<GGDosiType>(world_recording_.momentum_z_, total_number_of_voxels*sizeof(GGDosiType));
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,14 +456,10 @@ void GGEMSWorld::SavePhotonTracking(void) const
   mhdImage.SetDimensions(dimensions_);
   mhdImage.SetElementSizes(sizes_);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGint* photon_tracking_device = opencl_manager.GetDeviceBuffer<GGint>(world_recording_.photon_tracking_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGint), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) photon_tracking[i] = photon_tracking_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.photon_tracking_[j], photon_tracking_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGint* photon_tracking_device = opencl_manager.GetDeviceBuffer<GGint>(world_recording_.photon_tracking_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGint), 0);
+  std::copy(photon_tracking_device, photon_tracking_device + total_number_of_voxels, photon_tracking);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.photon_tracking_[0], photon_tracking_device, 0);
 
   // Writing data
   mhdImage.Write<GGint>(photon_tracking);
@@ -446,14 +486,10 @@ void GGEMSWorld::SaveEnergyTracking(void) const
   mhdImage.SetDimensions(dimensions_);
   mhdImage.SetElementSizes(sizes_);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.energy_tracking_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) edep_tracking[i] = edep_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.energy_tracking_[j], edep_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGDosiType* edep_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.energy_tracking_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), 0);
+  std::copy(edep_device, edep_device + total_number_of_voxels, edep_tracking);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.energy_tracking_[0], edep_device, 0);
 
   // Writing data
   mhdImage.Write<GGDosiType>(edep_tracking);
@@ -480,14 +516,10 @@ void GGEMSWorld::SaveEnergySquaredTracking(void) const
   mhdImage.SetDimensions(dimensions_);
   mhdImage.SetElementSizes(sizes_);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_squared_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.energy_squared_tracking_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) edep_squared_tracking[i] = edep_squared_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.energy_squared_tracking_[j], edep_squared_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGDosiType* edep_squared_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.energy_squared_tracking_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), 0);
+  std::copy(edep_squared_device, edep_squared_device + total_number_of_voxels, edep_squared_tracking);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.energy_squared_tracking_[0], edep_squared_device, 0);
 
   // Writing data
   mhdImage.Write<GGDosiType>(edep_squared_tracking);
@@ -535,40 +567,28 @@ void GGEMSWorld::SaveMomentum(void) const
   mhdImage_momentum_z.SetDimensions(dimensions_);
   mhdImage_momentum_z.SetElementSizes(sizes_);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* momentum_x_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_x_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) momentum_x[i] = momentum_x_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_x_[j], momentum_x_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGDosiType* momentum_x_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_x_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), 0);
+  std::copy(momentum_x_device, momentum_x_device + total_number_of_voxels, momentum_x);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_x_[0], momentum_x_device, 0);
 
   // Writing data
   mhdImage_momentum_x.Write<GGDosiType>(momentum_x);
   delete[] momentum_x;
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* momentum_y_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_y_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) momentum_y[i] = momentum_y_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_y_[j], momentum_y_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGDosiType* momentum_y_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_y_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), 0);
+  std::copy(momentum_y_device, momentum_y_device + total_number_of_voxels, momentum_y);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_y_[0], momentum_y_device, 0);
 
   // Writing data
   mhdImage_momentum_y.Write<GGDosiType>(momentum_y);
   delete[] momentum_y;
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* momentum_z_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_z_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_voxels; ++i) momentum_z[i] = momentum_z_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_z_[j], momentum_z_device, j);
-  }
+  // Tallies of all devices are summed on first device by ReduceTallies
+  GGDosiType* momentum_z_device = opencl_manager.GetDeviceBuffer<GGDosiType>(world_recording_.momentum_z_[0], CL_TRUE, CL_MAP_READ, total_number_of_voxels*sizeof(GGDosiType), 0);
+  std::copy(momentum_z_device, momentum_z_device + total_number_of_voxels, momentum_z);
+  opencl_manager.ReleaseDeviceBuffer(world_recording_.momentum_z_[0], momentum_z_device, 0);
 
   // Writing data
   mhdImage_momentum_z.Write<GGDosiType>(momentum_z);
@@ -28,10 +28,15 @@
   \date Tuesday January 18, 2022
 */
 
+#include <filesystem>
+#include <fstream>
+#include <random>
+
 #include "GGEMS/physics/GGEMSAttenuations.hh"
 #include "GGEMS/physics/GGEMSMuDataConstants.hh"
 #include "GGEMS/materials/GGEMSMaterials.hh"
 #include "GGEMS/physics/GGEMSCrossSections.hh"
+#include "GGEMS/physics/GGEMSProcessesManager.hh"
 #include "GGEMS/maths/GGEMSMathAlgorithms.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -125,8 +130,11 @@ void GGEMSAttenuations::Clean(void)
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
   if (mu_tables_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(mu_tables_[i], sizeof(GGEMSMuMuEnData), i);
+    // Tables shared with other navigators are deallocated by the last user
+    if (GGEMSProcessesManager::GetInstance().ReleaseSharedTables(table_key_)) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(mu_tables_[i], sizeof(GGEMSMuMuEnData), i);
+      }
     }
     delete[] mu_tables_;
     mu_tables_ = nullptr;
@@ -145,89 +153,158 @@ void GGEMSAttenuations::Initialize(void)
 
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  // Loop over the device and storing value for each materials
   mu_tables_ = new cl::Buffer*[number_activated_devices_];
+
+  // Attenuations depend only on materials, same materials as cross sections are used
+  table_key_ = "attenuations;" + cross_sections_->GetTableKey();
+  cl::Buffer* const* shared_tables = GGEMSProcessesManager::GetInstance().GetSharedTables(table_key_);
+  if (shared_tables) {
+    GGcout("GGEMSAttenuations", "Initialize", 1) << "Using attenuation tables already built by another navigator..." << GGendl;
+    for (GGsize d = 0; d < number_activated_devices_; ++d) mu_tables_[d] = shared_tables[d];
+    LoadAttenuationsOnHost();
+    return;
+  }
+
+  // Tables computed in a previous run, empty filename if cache disabled
+  std::string cache_directory = GGEMSProcessesManager::GetInstance().GetPhysicTablesCacheDirectory();
+  std::string cache_filename("");
+  if (!cache_directory.empty()) cache_filename = (std::filesystem::path(cache_directory) / ("attenuations_" + GGEMSMisc::HashContent(table_key_) + ".bin")).string();
+
+  // Tables are computed once on host then copied on each device
+  attenuations_host_->number_of_materials_ = static_cast<GGint>(materials_->GetNumberOfMaterials());
+  attenuations_host_->energy_max_ = ATTENUATION_ENERGY_MAX;
+  attenuations_host_->energy_min_ = ATTENUATION_ENERGY_MIN;
+  attenuations_host_->number_of_bins_ = ATTENUATION_TABLE_NUMBER_BINS;
+
+  // Fill energy table with log scale
+  GGfloat slope = logf(attenuations_host_->energy_max_ / attenuations_host_->energy_min_);
+  for (GGint i = 0; i < attenuations_host_->number_of_bins_; ++i) {
+    attenuations_host_->energy_bins_[i] = attenuations_host_->energy_min_ * expf(slope * (static_cast<GGfloat>(i) / (static_cast<GGfloat>(attenuations_host_->number_of_bins_)-1.0f)))*MeV;
+  }
+  attenuations_host_->log_energy_min_ = logf(attenuations_host_->energy_bins_[0]);
+  attenuations_host_->inverse_log_energy_step_ = (static_cast<GGfloat>(attenuations_host_->number_of_bins_)-1.0f) / slope;
+
+  bool is_loaded = !cache_filename.empty() && LoadAttenuationsFromCache(cache_filename, attenuations_host_);
+  if (is_loaded) {
+    GGcout("GGEMSAttenuations", "Initialize", 1) << "Attenuation tables read from cache file " << cache_filename << GGendl;
+  }
+  else {
+    // Materials are identical on each device, first device is used
+    GGEMSMaterialTables* materials_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(materials_->GetMaterialTables(0), CL_TRUE, CL_MAP_READ, sizeof(GGEMSMaterialTables), 0);
+
+    // For each material and energy bin compute mu and muen, each entry is computed by a host thread
+    GGsize number_of_bins = static_cast<GGsize>(attenuations_host_->number_of_bins_);
+    GGsize number_of_entries = static_cast<GGsize>(attenuations_host_->number_of_materials_) * number_of_bins;
+    GGEMSMisc::ParallelFor(number_of_entries, GGEMSProcessesManager::GetInstance().GetNumberOfHostThreads(), [&](GGsize const& abs_index) {
+      GGsize imat = abs_index / number_of_bins;
+
+      // Energy value
+      GGfloat energy = attenuations_host_->energy_bins_[abs_index % number_of_bins];
+
+      // For each element of the material
+      GGfloat mu_over_rho = 0.0f, mu_en_over_rho = 0.0f;
+      for (GGsize iZ = 0; iZ < materials_device->number_of_chemical_elements_[imat]; ++iZ) {
+        // Get Z and mass fraction
+        GGsize Z = materials_device->atomic_number_Z_[materials_device->index_of_chemical_elements_[imat] + iZ];
+        GGfloat frac = materials_device->mass_fraction_[materials_device->index_of_chemical_elements_[imat] + iZ];
+
+        // Get energy index
+        GGint mu_index_E = GGEMSMuDataConstants::kMuIndexEnergy[Z];
+        GGint E_index = BinarySearchLeft(energy, energies_, mu_index_E+GGEMSMuDataConstants::kMuNbEnergyBins[Z], 0, mu_index_E);
+
+        // Get mu an mu_en from interpolation
+        if ( E_index == mu_index_E ) {
+          mu_over_rho += mu_[E_index];
+          mu_en_over_rho += mu_en_[E_index];
+        }
+        else
+        {
+          mu_over_rho += frac * LinearInterpolation(energies_[E_index-1], mu_[E_index-1], energies_[E_index], mu_[E_index], energy);
+          mu_en_over_rho += frac * LinearInterpolation(energies_[E_index-1], mu_en_[E_index-1], energies_[E_index], mu_en_[E_index], energy);
+        }
+      }
+
+      // Store values
+      attenuations_host_->mu_[abs_index] = mu_over_rho * materials_device->density_of_material_[imat] / (g/cm3);
+      attenuations_host_->mu_en_[abs_index] = mu_en_over_rho * materials_device->density_of_material_[imat] / (g/cm3);
+    });
+
+    opencl_manager.ReleaseDeviceBuffer(materials_->GetMaterialTables(0), materials_device, 0);
+  }
+
+  // Copy tables on each device
   for (GGsize d = 0; d < number_activated_devices_; ++d) {
     // Allocating memory on OpenCL device
     mu_tables_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSMuMuEnData), d, CL_MEM_READ_WRITE, "GGEMSAttenuations");
 
-    // Getting the OpenCL pointer on Mu tables
-    GGEMSMuMuEnData* mu_table_device = opencl_manager.GetDeviceBuffer<GGEMSMuMuEnData>(mu_tables_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMuMuEnData), d);
-
-    cl::Buffer* particle_cs = cross_sections_->GetCrossSections(d);
-    GGEMSParticleCrossSections* particle_cs_device =  opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cs, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSParticleCrossSections), d);
+    GGEMSMuMuEnData* mu_table_device = opencl_manager.GetDeviceBuffer<GGEMSMuMuEnData>(mu_tables_[d], CL_TRUE, CL_MAP_WRITE, sizeof(GGEMSMuMuEnData), d);
+    *mu_table_device = *attenuations_host_;
+    opencl_manager.ReleaseDeviceBuffer(mu_tables_[d], mu_table_device, d);
+  }
 
-    mu_table_device->number_of_materials_ = static_cast<GGint>(particle_cs_device->number_of_materials_);
-    mu_table_device->energy_max_ = ATTENUATION_ENERGY_MAX;
-    mu_table_device->energy_min_ = ATTENUATION_ENERGY_MIN;
-    mu_table_device->number_of_bins_ = ATTENUATION_TABLE_NUMBER_BINS;
+  // Other navigators with same materials use these tables
+  GGEMSProcessesManager::GetInstance().RegisterSharedTables(table_key_, mu_tables_, number_activated_devices_);
 
-    opencl_manager.ReleaseDeviceBuffer(particle_cs, particle_cs_device, d);
+  // Storing computed tables for next runs
+  if (!cache_filename.empty() && !is_loaded) SaveAttenuationsToCache(cache_filename);
+}
 
-    // Fill energy table with log scale
-    GGfloat slope = logf(mu_table_device->energy_max_ / mu_table_device->energy_min_);
-    GGint i = 0;
-    while (i < mu_table_device->number_of_bins_) {
-      mu_table_device->energy_bins_[i] = mu_table_device->energy_min_ * expf(slope * (static_cast<GGfloat>(i) / (static_cast<GGfloat>(mu_table_device->number_of_bins_)-1.0f)))*MeV;
-      ++i;
-    }
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
-    GGEMSMaterialTables* materials_device =  opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(materials_->GetMaterialTables(d), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), d);
-
-    // For each material and energy bin compute mu and muen
-    GGint imat = 0;
-    GGint abs_index, E_index, mu_index_E;
-    GGsize iZ, Z;
-    GGfloat energy, mu_over_rho, mu_en_over_rho, frac;
-    while (imat < mu_table_device->number_of_materials_) {
-      // for each energy bin
-      i=0;
-      while (i < mu_table_device->number_of_bins_) {
-        // absolute index to store data within the table
-        abs_index = imat*mu_table_device->number_of_bins_ + i;
-
-        // Energy value
-        energy = mu_table_device->energy_bins_[i];
-
-        // For each element of the material
-        mu_over_rho = 0.0f; mu_en_over_rho = 0.0f;
-        iZ=0;
-        while (iZ < materials_device->number_of_chemical_elements_[imat]) {
-          // Get Z and mass fraction
-          Z = materials_device->atomic_number_Z_[materials_device->index_of_chemical_elements_[imat] + iZ];
-          frac = materials_device->mass_fraction_[materials_device->index_of_chemical_elements_[imat] + iZ];
-
-          // Get energy index
-          mu_index_E = GGEMSMuDataConstants::kMuIndexEnergy[Z];
-          E_index = BinarySearchLeft(energy, energies_, mu_index_E+GGEMSMuDataConstants::kMuNbEnergyBins[Z], 0, mu_index_E);
-
-          // Get mu an mu_en from interpolation
-          if ( E_index == mu_index_E ) {
-            mu_over_rho += mu_[E_index];
-            mu_en_over_rho += mu_en_[E_index];
-          }
-          else
-          {
-            mu_over_rho += frac * LinearInterpolation(energies_[E_index-1], mu_[E_index-1], energies_[E_index], mu_[E_index], energy);
-            mu_en_over_rho += frac * LinearInterpolation(energies_[E_index-1], mu_en_[E_index-1], energies_[E_index], mu_en_[E_index], energy);
-          }
-          ++iZ;
-        }
+bool GGEMSAttenuations::LoadAttenuationsFromCache(std::string const& filename, GGEMSMuMuEnData* attenuations) const
+{
+  std::ifstream cache_stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!cache_stream) return false;
+
+  // Full key is stored in file, checking it avoids any hash collision
+  GGsize key_size = 0;
+  cache_stream.read(reinterpret_cast<char*>(&key_size), sizeof(GGsize));
+  if (!cache_stream || key_size != table_key_.size()) return false;
+  std::string key(key_size, '\0');
+  cache_stream.read(&key[0], static_cast<std::streamsize>(key_size));
+  if (!cache_stream || key != table_key_) return false;
+
+  // Only the used part of tables is stored
+  GGsize table_size = static_cast<GGsize>(attenuations->number_of_materials_*attenuations->number_of_bins_);
+  cache_stream.read(reinterpret_cast<char*>(attenuations->mu_), static_cast<std::streamsize>(table_size*sizeof(GGfloat)));
+  cache_stream.read(reinterpret_cast<char*>(attenuations->mu_en_), static_cast<std::streamsize>(table_size*sizeof(GGfloat)));
+
+  return static_cast<bool>(cache_stream);
+}
 
-        // Store values
-        mu_table_device->mu_[abs_index] = mu_over_rho * materials_device->density_of_material_[imat] / (g/cm3);
-        mu_table_device->mu_en_[abs_index] = mu_en_over_rho * materials_device->density_of_material_[imat] / (g/cm3);
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
-        ++i;
-      } // E bin
-      ++imat;
-    }
-    opencl_manager.ReleaseDeviceBuffer(mu_tables_[d], mu_table_device, d);
-    opencl_manager.ReleaseDeviceBuffer(materials_->GetMaterialTables(d), materials_device, d);
+void GGEMSAttenuations::SaveAttenuationsToCache(std::string const& filename) const
+{
+  GGcout("GGEMSAttenuations", "SaveAttenuationsToCache", 1) << "Saving attenuation tables in cache file " << filename << GGendl;
+
+  // Creating cache directory if necessary
+  std::error_code error_code;
+  std::filesystem::create_directories(std::filesystem::path(filename).parent_path(), error_code);
+
+  // Writing in a temporary file then renaming it, several GGEMS processes could share the same cache
+  std::string tmp_filename = filename + ".tmp" + std::to_string(std::random_device{}());
+  std::ofstream cache_stream(tmp_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!cache_stream) {
+    GGwarn("GGEMSAttenuations", "SaveAttenuationsToCache", 1) << "Impossible to write in physic tables cache: " << filename << GGendl;
+    return;
   }
 
-  // Copy data from device to RAM memory (optimization for python users)
-  LoadAttenuationsOnHost();
+  GGsize key_size = table_key_.size();
+  cache_stream.write(reinterpret_cast<char const*>(&key_size), sizeof(GGsize));
+  cache_stream.write(table_key_.data(), static_cast<std::streamsize>(key_size));
+
+  GGsize table_size = static_cast<GGsize>(attenuations_host_->number_of_materials_*attenuations_host_->number_of_bins_);
+  cache_stream.write(reinterpret_cast<char const*>(attenuations_host_->mu_), static_cast<std::streamsize>(table_size*sizeof(GGfloat)));
+  cache_stream.write(reinterpret_cast<char const*>(attenuations_host_->mu_en_), static_cast<std::streamsize>(table_size*sizeof(GGfloat)));
+  cache_stream.close();
+
+  std::filesystem::rename(tmp_filename, filename, error_code);
+  if (error_code) std::filesystem::remove(tmp_filename, error_code);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -253,7 +330,7 @@ void GGEMSAttenuations::LoadAttenuationsOnHost(void)
     attenuations_host_->energy_bins_[i] = attenuations_device->energy_bins_[i];
   }
 
-  for(GGint i = 0; i < 256*ATTENUATION_TABLE_NUMBER_BINS; ++i) {
+  for(GGint i = 0; i < MAXIMUM_MATERIALS*ATTENUATION_TABLE_NUMBER_BINS; ++i) {
     attenuations_host_->mu_[i] = attenuations_device->mu_[i];
     attenuations_host_->mu_en_[i] = attenuations_device->mu_en_[i];
   }
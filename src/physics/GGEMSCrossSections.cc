@@ -28,6 +28,12 @@
   \date Tuesday March 31, 2020
 */
 
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <new>
+#include <cstring>
+
 #include "GGEMS/physics/GGEMSCrossSections.hh"
 #include "GGEMS/physics/GGEMSComptonScattering.hh"
 #include "GGEMS/physics/GGEMSPhotoElectricEffect.hh"
@@ -55,14 +61,13 @@ GGEMSCrossSections::GGEMSCrossSections(GGEMSMaterials* materials)
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
   number_activated_devices_ = opencl_manager.GetNumberOfActivatedDevice();
 
-  // Allocating memory for cross section tables on host and device
+  // Tables are allocated during initialization, size depends on materials and bins
   particle_cross_sections_ = new cl::Buffer*[number_activated_devices_];
-  for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    particle_cross_sections_[i] = opencl_manager.Allocate(nullptr, sizeof(GGEMSParticleCrossSections), i, CL_MEM_READ_WRITE, "GGEMSCrossSections");
-  }
+  for (GGsize i = 0; i < number_activated_devices_; ++i) particle_cross_sections_[i] = nullptr;
+  particle_cross_sections_size_ = 0;
 
   // Useful to avoid memory transfer between host and OpenCL
-  particle_cross_sections_host_ = new GGEMSParticleCrossSections();
+  particle_cross_sections_host_ = nullptr;
 
   materials_ = materials;
 
@@ -87,7 +92,7 @@ GGEMSCrossSections::~GGEMSCrossSections(void)
   }
 
   if (particle_cross_sections_host_) {
-    delete particle_cross_sections_host_;
+    ::operator delete(particle_cross_sections_host_);
     particle_cross_sections_host_ = nullptr;
   }
 
@@ -105,8 +110,11 @@ void GGEMSCrossSections::Clean(void)
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
   if (particle_cross_sections_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(particle_cross_sections_[i], sizeof(GGEMSParticleCrossSections), i);
+    // Tables shared with other navigators are deallocated by the last user
+    if (GGEMSProcessesManager::GetInstance().ReleaseSharedTables(table_key_)) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        if (particle_cross_sections_[i]) opencl_manager.Deallocate(particle_cross_sections_[i], particle_cross_sections_size_, i);
+      }
     }
     delete[] particle_cross_sections_;
     particle_cross_sections_ = nullptr;
@@ -183,87 +191,242 @@ void GGEMSCrossSections::Initialize(void)
   GGfloat min_energy = process_manager.GetCrossSectionTableMinEnergy();
   GGfloat max_energy = process_manager.GetCrossSectionTableMaxEnergy();
 
-  // Initialize physics on each device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGEMSParticleCrossSections* particle_cross_sections_device = opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cross_sections_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSParticleCrossSections), j);
-
-    particle_cross_sections_device->number_of_bins_ = number_of_bins;
-    particle_cross_sections_device->min_energy_ = min_energy;
-    particle_cross_sections_device->max_energy_ = max_energy;
-    for (GGsize i = 0; i < materials_->GetNumberOfMaterials(); ++i) {
-      #ifdef _WIN32
-      strcpy_s(reinterpret_cast<char*>(particle_cross_sections_device->material_names_[i]), 32, (materials_->GetMaterialName(i)).c_str());
-      #else
-      strcpy(reinterpret_cast<char*>(particle_cross_sections_device->material_names_[i]), (materials_->GetMaterialName(i)).c_str());
-      #endif
-    }
+  // Tables are sized with the real number of materials and bins, only activated processes have tables
+  GGsize number_of_materials = materials_->GetNumberOfMaterials();
+  GGsize number_of_table_values = number_of_activated_processes_ * (number_of_materials + 101) * number_of_bins;
+  particle_cross_sections_size_ = sizeof(GGEMSParticleCrossSections) + number_of_table_values * sizeof(GGfloat);
+
+  // Header followed by tables on host, same layout as OpenCL buffer
+  if (particle_cross_sections_host_) ::operator delete(particle_cross_sections_host_);
+  particle_cross_sections_host_ = new(::operator new(particle_cross_sections_size_)) GGEMSParticleCrossSections();
+  std::memset(particle_cross_sections_host_ + 1, 0, number_of_table_values * sizeof(GGfloat));
+
+  particle_cross_sections_host_->number_of_table_values_ = number_of_table_values;
+  for (GGsize i = 0; i < number_of_activated_processes_; ++i) {
+    GGchar process_id = em_processes_list_[i]->GetProcessID();
+    particle_cross_sections_host_->photon_cross_sections_offset_[process_id] = i * number_of_materials * number_of_bins;
+    particle_cross_sections_host_->photon_cross_sections_per_atom_offset_[process_id] = (number_of_activated_processes_ * number_of_materials + i * 101) * number_of_bins;
+  }
 
-    // Storing information from materials
-    particle_cross_sections_device->number_of_materials_ = static_cast<GGuchar>(materials_->GetNumberOfMaterials());
+  // Tables with same materials, processes and energy range are built only once
+  table_key_ = BuildTableKey();
+  cl::Buffer* const* shared_tables = process_manager.GetSharedTables(table_key_);
+  if (shared_tables) {
+    GGcout("GGEMSCrossSections", "Initialize", 1) << "Using cross section tables already built by another navigator..." << GGendl;
+    for (GGsize j = 0; j < number_activated_devices_; ++j) particle_cross_sections_[j] = shared_tables[j];
+    LoadPhysicTablesOnHost();
+    return;
+  }
 
-    // Filling energy table with log scale
-    GGfloat slope = logf(max_energy/min_energy);
-    for (GGsize i = 0; i < number_of_bins; ++i) {
-      particle_cross_sections_device->energy_bins_[i] = min_energy * expf(slope * (static_cast<float>(i) / (static_cast<GGfloat>(number_of_bins)-1.0f))) * MeV;
-    }
+  // Tables are computed once on host then copied on each device
+  particle_cross_sections_host_->number_of_bins_ = number_of_bins;
+  particle_cross_sections_host_->min_energy_ = min_energy;
+  particle_cross_sections_host_->max_energy_ = max_energy;
+  particle_cross_sections_host_->number_of_materials_ = number_of_materials;
 
-    // Release pointer
-    opencl_manager.ReleaseDeviceBuffer(particle_cross_sections_[j], particle_cross_sections_device, j);
+  // Filling energy table with log scale
+  GGfloat slope = logf(max_energy/min_energy);
+  for (GGsize i = 0; i < number_of_bins; ++i) {
+    particle_cross_sections_host_->energy_bins_[i] = min_energy * expf(slope * (static_cast<float>(i) / (static_cast<GGfloat>(number_of_bins)-1.0f))) * MeV;
+  }
+  particle_cross_sections_host_->log_energy_min_ = logf(particle_cross_sections_host_->energy_bins_[0]);
+  particle_cross_sections_host_->inverse_log_energy_step_ = (static_cast<GGfloat>(number_of_bins)-1.0f) / slope;
+
+  // Tables computed in a previous run, empty filename if cache disabled
+  std::string cache_filename = GetCacheFilename();
+  bool is_loaded = !cache_filename.empty() && LoadTablesFromCache(cache_filename, particle_cross_sections_host_);
+
+  if (is_loaded) {
+    GGcout("GGEMSCrossSections", "Initialize", 1) << "Cross section tables read from cache file " << cache_filename << GGendl;
+  }
+  else {
+    // Materials are identical on each device, first device is used
+    GGEMSMaterialTables* materials_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(materials_->GetMaterialTables(0), CL_TRUE, CL_MAP_READ, sizeof(GGEMSMaterialTables), 0);
 
     // Loop over the activated physic processes and building tables
+    particle_cross_sections_host_->number_of_activated_photon_processes_ = 0;
     for (GGsize i = 0; i < number_of_activated_processes_; ++i)
-      em_processes_list_[i]->BuildCrossSectionTables(particle_cross_sections_[j], materials_->GetMaterialTables(j), j);
+      em_processes_list_[i]->BuildCrossSectionTables(particle_cross_sections_host_, materials_device, materials_);
+
+    opencl_manager.ReleaseDeviceBuffer(materials_->GetMaterialTables(0), materials_device, 0);
+  }
+
+  // Majorant cross section from activated processes
+  ComputeMajorantCrossSections();
+
+  // Allocating and copying tables on each device
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    particle_cross_sections_[j] = opencl_manager.Allocate(nullptr, particle_cross_sections_size_, j, CL_MEM_READ_WRITE, "GGEMSCrossSections");
+    GGEMSParticleCrossSections* particle_cross_sections_device = opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cross_sections_[j], CL_TRUE, CL_MAP_WRITE, particle_cross_sections_size_, j);
+    std::memcpy(particle_cross_sections_device, particle_cross_sections_host_, particle_cross_sections_size_);
+    opencl_manager.ReleaseDeviceBuffer(particle_cross_sections_[j], particle_cross_sections_device, j);
   }
 
-  // Copy data from device to RAM memory (optimization for python users)
-  LoadPhysicTablesOnHost();
+  // Other navigators with same content use these tables
+  process_manager.RegisterSharedTables(table_key_, particle_cross_sections_, number_activated_devices_);
+
+  // Storing computed tables for next runs
+  if (!cache_filename.empty() && !is_loaded) SaveTablesToCache(cache_filename);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSCrossSections::LoadPhysicTablesOnHost(void)
+std::string GGEMSCrossSections::BuildTableKey(void) const
 {
-  GGcout("GGEMSCrossSections", "LoadPhysicTablesOnHost", 1) << "Loading physic tables from OpenCL device to host (RAM)..." << GGendl;
-
-  // Get the OpenCL manager
+  GGEMSProcessesManager& process_manager = GGEMSProcessesManager::GetInstance();
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  GGEMSParticleCrossSections* particle_cross_sections_device = opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cross_sections_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSParticleCrossSections), 0);
-
-  particle_cross_sections_host_->number_of_bins_ = particle_cross_sections_device->number_of_bins_;
-  particle_cross_sections_host_->number_of_materials_ = particle_cross_sections_device->number_of_materials_;
-  particle_cross_sections_host_->min_energy_ = particle_cross_sections_device->min_energy_;
-  particle_cross_sections_host_->max_energy_ = particle_cross_sections_device->max_energy_;
-
-  for(GGuchar i = 0; i < particle_cross_sections_host_->number_of_materials_; ++i) {
-    for(GGuchar j = 0; j < 32; ++j) {
-      particle_cross_sections_host_->material_names_[i][j] = particle_cross_sections_device->material_names_[i][j];
+  // Order of processes and materials changes the tables, both are kept
+  std::ostringstream oss(std::ostringstream::out);
+  #ifdef GGEMS_VERSION
+  oss << "GGEMS " << GGEMS_VERSION << ";";
+  #endif
+  oss << std::hexfloat << process_manager.GetCrossSectionTableNumberOfBins() << ";"
+    << process_manager.GetCrossSectionTableMinEnergy() << ";"
+    << process_manager.GetCrossSectionTableMaxEnergy() << ";";
+
+  for (GGsize i = 0; i < number_of_activated_processes_; ++i) oss << em_processes_list_[i]->GetProcessName() << ",";
+  oss << ";";
+
+  // Composition and density of materials, a material modified in database gives another key
+  GGEMSMaterialTables* materials_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(materials_->GetMaterialTables(0), CL_TRUE, CL_MAP_READ, sizeof(GGEMSMaterialTables), 0);
+
+  for (GGsize i = 0; i < materials_->GetNumberOfMaterials(); ++i) {
+    oss << materials_->GetMaterialName(i) << ":" << materials_device->density_of_material_[i];
+    for (GGsize j = 0; j < materials_device->number_of_chemical_elements_[i]; ++j) {
+      GGsize element_index = materials_device->index_of_chemical_elements_[i] + j;
+      oss << ":" << static_cast<GGint>(materials_device->atomic_number_Z_[element_index]) << "=" << materials_device->mass_fraction_[element_index];
     }
+    oss << ",";
   }
 
-  for(GGushort i = 0; i < particle_cross_sections_host_->number_of_bins_; ++i) {
-    particle_cross_sections_host_->energy_bins_[i] = particle_cross_sections_device->energy_bins_[i];
-  }
+  opencl_manager.ReleaseDeviceBuffer(materials_->GetMaterialTables(0), materials_device, 0);
 
-  particle_cross_sections_host_->number_of_activated_photon_processes_ = particle_cross_sections_device->number_of_activated_photon_processes_;
+  return oss.str();
+}
 
-  for(GGuchar i = 0; i < NUMBER_PHOTON_PROCESSES; ++i) {
-    particle_cross_sections_host_->photon_cs_id_[i] = particle_cross_sections_device->photon_cs_id_[i];
-  }
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
 
-  for(GGuchar j = 0; j < NUMBER_PHOTON_PROCESSES; ++j) {
-    for(GGuint i = 0; i < 256*MAX_CROSS_SECTION_TABLE_NUMBER_BINS; ++i) {
-      particle_cross_sections_host_->photon_cross_sections_[j][i] = particle_cross_sections_device->photon_cross_sections_[j][i];
-    }
+std::string GGEMSCrossSections::GetCacheFilename(void) const
+{
+  std::string cache_directory = GGEMSProcessesManager::GetInstance().GetPhysicTablesCacheDirectory();
+  if (cache_directory.empty()) return std::string("");
+
+  return (std::filesystem::path(cache_directory) / ("cross_sections_" + GGEMSMisc::HashContent(table_key_) + ".bin")).string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSCrossSections::LoadTablesFromCache(std::string const& filename, GGEMSParticleCrossSections* particle_cross_sections) const
+{
+  std::ifstream cache_stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!cache_stream) return false;
+
+  // Full key is stored in file, checking it avoids any hash collision
+  GGsize key_size = 0;
+  cache_stream.read(reinterpret_cast<char*>(&key_size), sizeof(GGsize));
+  if (!cache_stream || key_size != table_key_.size()) return false;
+  std::string key(key_size, '\0');
+  cache_stream.read(&key[0], static_cast<std::streamsize>(key_size));
+  if (!cache_stream || key != table_key_) return false;
+
+  GGsize number_of_activated_photon_processes = 0;
+  GGchar photon_cs_id[NUMBER_PHOTON_PROCESSES];
+  GGsize number_of_table_values = 0;
+  cache_stream.read(reinterpret_cast<char*>(&number_of_activated_photon_processes), sizeof(GGsize));
+  cache_stream.read(reinterpret_cast<char*>(photon_cs_id), sizeof(photon_cs_id));
+  cache_stream.read(reinterpret_cast<char*>(&number_of_table_values), sizeof(GGsize));
+  if (!cache_stream || number_of_activated_photon_processes > NUMBER_PHOTON_PROCESSES || number_of_table_values != particle_cross_sections->number_of_table_values_) return false;
+
+  // Tables are stored as in memory, offsets are given by the ordered processes of the key
+  cache_stream.read(reinterpret_cast<char*>(particle_cross_sections + 1), static_cast<std::streamsize>(number_of_table_values*sizeof(GGfloat)));
+  if (!cache_stream) return false;
+
+  particle_cross_sections->number_of_activated_photon_processes_ = number_of_activated_photon_processes;
+  for (GGsize i = 0; i < NUMBER_PHOTON_PROCESSES; ++i) particle_cross_sections->photon_cs_id_[i] = photon_cs_id[i];
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCrossSections::SaveTablesToCache(std::string const& filename) const
+{
+  GGcout("GGEMSCrossSections", "SaveTablesToCache", 1) << "Saving cross section tables in cache file " << filename << GGendl;
+
+  // Creating cache directory if necessary
+  std::error_code error_code;
+  std::filesystem::create_directories(std::filesystem::path(filename).parent_path(), error_code);
+
+  // Writing in a temporary file then renaming it, several GGEMS processes could share the same cache
+  std::string tmp_filename = filename + ".tmp" + std::to_string(std::random_device{}());
+  std::ofstream cache_stream(tmp_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!cache_stream) {
+    GGwarn("GGEMSCrossSections", "SaveTablesToCache", 1) << "Impossible to write in physic tables cache: " << filename << GGendl;
+    return;
   }
 
-  for(GGuchar j = 0; j < NUMBER_PHOTON_PROCESSES; ++j) {
-    for(GGuint i = 0; i < 101*MAX_CROSS_SECTION_TABLE_NUMBER_BINS; ++i) {
-      particle_cross_sections_host_->photon_cross_sections_per_atom_[j][i] = particle_cross_sections_device->photon_cross_sections_per_atom_[j][i];
+  GGsize key_size = table_key_.size();
+  cache_stream.write(reinterpret_cast<char const*>(&key_size), sizeof(GGsize));
+  cache_stream.write(table_key_.data(), static_cast<std::streamsize>(key_size));
+
+  cache_stream.write(reinterpret_cast<char const*>(&particle_cross_sections_host_->number_of_activated_photon_processes_), sizeof(GGsize));
+  cache_stream.write(reinterpret_cast<char const*>(particle_cross_sections_host_->photon_cs_id_), sizeof(particle_cross_sections_host_->photon_cs_id_));
+
+  cache_stream.write(reinterpret_cast<char const*>(&particle_cross_sections_host_->number_of_table_values_), sizeof(GGsize));
+  cache_stream.write(reinterpret_cast<char const*>(particle_cross_sections_host_ + 1), static_cast<std::streamsize>(particle_cross_sections_host_->number_of_table_values_*sizeof(GGfloat)));
+  cache_stream.close();
+
+  std::filesystem::rename(tmp_filename, filename, error_code);
+  if (error_code) std::filesystem::remove(tmp_filename, error_code);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCrossSections::ComputeMajorantCrossSections(void)
+{
+  GGsize number_of_bins = particle_cross_sections_host_->number_of_bins_;
+  GGsize number_of_materials = particle_cross_sections_host_->number_of_materials_;
+
+  for (GGsize i = 0; i < number_of_bins; ++i) {
+    GGfloat majorant = 0.0f;
+    for (GGsize j = 0; j < number_of_materials; ++j) {
+      GGfloat total_cross_section = 0.0f;
+      for (GGsize k = 0; k < particle_cross_sections_host_->number_of_activated_photon_processes_; ++k) {
+        GGchar process_id = particle_cross_sections_host_->photon_cs_id_[k];
+        total_cross_section += GetPhotonCrossSections(particle_cross_sections_host_, process_id)[i + number_of_bins*j];
+      }
+      if (total_cross_section > majorant) majorant = total_cross_section;
     }
+    particle_cross_sections_host_->photon_majorant_cross_sections_[i] = majorant;
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCrossSections::LoadPhysicTablesOnHost(void)
+{
+  GGcout("GGEMSCrossSections", "LoadPhysicTablesOnHost", 1) << "Loading physic tables from OpenCL device to host (RAM)..." << GGendl;
+
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGEMSParticleCrossSections* particle_cross_sections_device = opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cross_sections_[0], CL_TRUE, CL_MAP_READ, particle_cross_sections_size_, 0);
+
+  // Header and tables
+  std::memcpy(particle_cross_sections_host_, particle_cross_sections_device, particle_cross_sections_size_);
 
   // Release pointer
   opencl_manager.ReleaseDeviceBuffer(particle_cross_sections_[0], particle_cross_sections_device, 0);
@@ -310,10 +473,13 @@ GGfloat GGEMSCrossSections::GetPhotonCrossSection(std::string const& process_nam
     GGEMSMisc::ThrowException("GGEMSCrossSections", "GetPhotonCrossSection", oss.str());
   }
 
+  // Inactivated process has no table
+  if (!is_process_activated_.at(process_id)) return 0.0f;
+
   // Get id of material
   GGsize mat_id = 0;
   for (GGsize i = 0; i < number_of_materials; ++i) {
-    if (strcmp(material_name.c_str(), reinterpret_cast<char*>(particle_cross_sections_host_->material_names_[i])) == 0) {
+    if (material_name == materials_->GetMaterialName(i)) {
       mat_id = i;
       break;
     }
@@ -329,8 +495,9 @@ GGfloat GGEMSCrossSections::GetPhotonCrossSection(std::string const& process_nam
   // Compute cross section using linear interpolation
   GGfloat energy_a = particle_cross_sections_host_->energy_bins_[energy_bin];
   GGfloat energy_b = particle_cross_sections_host_->energy_bins_[energy_bin+1];
-  GGfloat cross_section_a = particle_cross_sections_host_->photon_cross_sections_[process_id][energy_bin + number_of_bins*mat_id];
-  GGfloat cross_section_b = particle_cross_sections_host_->photon_cross_sections_[process_id][energy_bin+1 + number_of_bins*mat_id];
+  GGfloat const* photon_cross_sections = GetPhotonCrossSections(particle_cross_sections_host_, static_cast<GGchar>(process_id));
+  GGfloat cross_section_a = photon_cross_sections[energy_bin + number_of_bins*mat_id];
+  GGfloat cross_section_b = photon_cross_sections[energy_bin+1 + number_of_bins*mat_id];
 
   GGfloat cross_section = LinearInterpolation(energy_a, cross_section_a, energy_b, cross_section_b, e_MeV);
 
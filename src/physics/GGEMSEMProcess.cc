@@ -30,6 +30,7 @@
 
 #include "GGEMS/physics/GGEMSProcessesManager.hh"
 #include "GGEMS/physics/GGEMSEMProcess.hh"
+#include "GGEMS/materials/GGEMSMaterials.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,64 +63,50 @@ GGEMSEMProcess::~GGEMSEMProcess(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSEMProcess::BuildCrossSectionTables(cl::Buffer* particle_cross_sections, cl::Buffer* material_tables, GGsize const& thread_index)
+void GGEMSEMProcess::BuildCrossSectionTables(GGEMSParticleCrossSections* particle_cross_sections, GGEMSMaterialTables const* material_tables, GGEMSMaterials const* materials)
 {
-  // Getting OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
-
-  GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 3) << "Building cross section table for process " << process_name_ << " on device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
-
-  // Set missing information in cross section table
-  GGEMSParticleCrossSections* cross_section_device = opencl_manager.GetDeviceBuffer<GGEMSParticleCrossSections>(particle_cross_sections, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSParticleCrossSections), thread_index);
+  GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 3) << "Building cross section table for process " << process_name_ << "..." << GGendl;
 
   // Store index of activated process
-  cross_section_device->photon_cs_id_[cross_section_device->number_of_activated_photon_processes_] = process_id_;
+  particle_cross_sections->photon_cs_id_[particle_cross_sections->number_of_activated_photon_processes_] = process_id_;
 
   // Increment number of activated photon process
-  cross_section_device->number_of_activated_photon_processes_ += 1;
-
-  // Get the material tables
-  GGEMSMaterialTables* materials_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(material_tables, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), thread_index);
-
-  // Compute Compton cross section par material
-  GGsize number_of_bins = cross_section_device->number_of_bins_;
-  // Loop over the materials
-  for (GGsize j = 0; j < materials_device->number_of_materials_; ++j) {
-    // Loop over the number of bins
-    for (GGsize i = 0; i < number_of_bins; ++i) {
-      cross_section_device->photon_cross_sections_[process_id_][i + j*number_of_bins] = ComputeCrossSectionPerMaterial(cross_section_device, materials_device, j, i);
+  particle_cross_sections->number_of_activated_photon_processes_ += 1;
+
+  // Compute cross section per material, one task per energy bin so each thread writes its own entries (per atom too)
+  GGsize number_of_bins = particle_cross_sections->number_of_bins_;
+  GGsize number_of_materials = material_tables->number_of_materials_;
+  GGfloat* photon_cross_sections = GetPhotonCrossSections(particle_cross_sections, process_id_);
+  GGEMSMisc::ParallelFor(number_of_bins, GGEMSProcessesManager::GetInstance().GetNumberOfHostThreads(), [&](GGsize const& i) {
+    for (GGsize j = 0; j < number_of_materials; ++j) {
+      photon_cross_sections[i + j*number_of_bins] = ComputeCrossSectionPerMaterial(particle_cross_sections, material_tables, j, i);
     }
-  }
+  });
 
   // If flag activate print tables
   GGEMSProcessesManager& process_manager = GGEMSProcessesManager::GetInstance();
   if (process_manager.IsPrintPhysicTables()) {
-    GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "* PROCESS " << process_name_ << " on device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
+    GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "* PROCESS " << process_name_ << GGendl;
 
     // Loop over material
-    for (GGsize j = 0; j < materials_device->number_of_materials_; ++j) {
-      GGsize id_elt = materials_device->index_of_chemical_elements_[j];
-      GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "    - Material: " << cross_section_device->material_names_[j]
-        << ", density: " << materials_device->density_of_material_[j]/(g/cm3) << " g.cm-3" << GGendl;
+    for (GGsize j = 0; j < number_of_materials; ++j) {
+      GGsize id_elt = material_tables->index_of_chemical_elements_[j];
+      GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "    - Material: " << materials->GetMaterialName(j)
+        << ", density: " << material_tables->density_of_material_[j]/(g/cm3) << " g.cm-3" << GGendl;
       // Loop over number of bins (energy)
       for (GGsize i = 0; i < number_of_bins; ++i) {
-        GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "        + Energy: " << cross_section_device->energy_bins_[i]/keV << " keV, cross section: "
-          << (cross_section_device->photon_cross_sections_[process_id_][i + j*number_of_bins]/materials_device->density_of_material_[j])/(cm2/g) << " cm2.g-1" << GGendl;
+        GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "        + Energy: " << particle_cross_sections->energy_bins_[i]/keV << " keV, cross section: "
+          << (photon_cross_sections[i + j*number_of_bins]/material_tables->density_of_material_[j])/(cm2/g) << " cm2.g-1" << GGendl;
         // Loop over elements
-        for (GGsize k = 0; k < materials_device->number_of_chemical_elements_[j]; ++k) {
-          GGuchar atomic_number = materials_device->atomic_number_Z_[k+id_elt];
+        for (GGsize k = 0; k < material_tables->number_of_chemical_elements_[j]; ++k) {
+          GGuchar atomic_number = material_tables->atomic_number_Z_[k+id_elt];
           GGcout("GGEMSEMProcess", "BuildCrossSectionTables", 0) << "            # Element (Z): " << atomic_number
-            << ", atomic number density: " << materials_device->atomic_number_density_[k+id_elt]/(1/cm3) << " atom/cm3, cross section per atom: "
-            << cross_section_device->photon_cross_sections_per_atom_[process_id_][i + atomic_number*number_of_bins]/(cm2)<< " cm2" << GGendl;
+            << ", atomic number density: " << material_tables->atomic_number_density_[k+id_elt]/(1/cm3) << " atom/cm3, cross section per atom: "
+            << GetPhotonCrossSectionsPerAtom(particle_cross_sections, process_id_)[i + atomic_number*number_of_bins]/(cm2)<< " cm2" << GGendl;
         }
       }
     }
   }
-
-  // Release pointer
-  opencl_manager.ReleaseDeviceBuffer(material_tables, materials_device, thread_index);
-  opencl_manager.ReleaseDeviceBuffer(particle_cross_sections, cross_section_device, thread_index);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -136,7 +123,7 @@ GGfloat GGEMSEMProcess::ComputeCrossSectionPerMaterial(GGEMSParticleCrossSection
   for (GGsize i = 0; i < material_tables->number_of_chemical_elements_[material_index]; ++i) {
     GGuchar atomic_number = material_tables->atomic_number_Z_[i+index_of_offset];
     GGfloat cross_section_per_atom = ComputeCrossSectionPerAtom(energy, atomic_number);
-    cross_section_device->photon_cross_sections_per_atom_[process_id_][energy_index + atomic_number*cross_section_device->number_of_bins_] = cross_section_per_atom;
+    GetPhotonCrossSectionsPerAtom(cross_section_device, process_id_)[energy_index + atomic_number*cross_section_device->number_of_bins_] = cross_section_per_atom;
     cross_section_material += material_tables->atomic_number_density_[i+index_of_offset] * cross_section_per_atom;
   }
   return cross_section_material;
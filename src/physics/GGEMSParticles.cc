@@ -28,6 +28,8 @@
   \date Thrusday October 3, 2019
 */
 
+#include <cstddef>
+
 #include "GGEMS/physics/GGEMSPrimaryParticles.hh"
 #include "GGEMS/sources/GGEMSSourceManager.hh"
 #include "GGEMS/tools/GGEMSRAMManager.hh"
@@ -40,7 +42,15 @@
 GGEMSParticles::GGEMSParticles(void)
 : number_of_particles_(nullptr),
   primary_particles_(nullptr),
-  kernel_alive_(nullptr)
+  particle_buffer_size_(0),
+  kernel_alive_(nullptr),
+  is_compaction_(false),
+  number_of_groups_(0),
+  compacted_particles_(nullptr),
+  group_alive_(nullptr),
+  kernel_count_alive_(nullptr),
+  kernel_scan_alive_(nullptr),
+  kernel_compact_particles_(nullptr)
 {
   GGcout("GGEMSParticles", "GGEMSParticles", 3) << "GGEMSParticles creating..." << GGendl;
 
@@ -64,7 +74,7 @@ GGEMSParticles::~GGEMSParticles(void)
 
   if (primary_particles_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(primary_particles_[i], sizeof(GGEMSPrimaryParticles), i);
+      opencl_manager.Deallocate(primary_particles_[i], particle_buffer_size_, i);
       opencl_manager.Deallocate(status_[i], sizeof(GGint), i);
     }
     delete[] primary_particles_;
@@ -78,6 +88,32 @@ GGEMSParticles::~GGEMSParticles(void)
     kernel_alive_ = nullptr;
   }
 
+  if (compacted_particles_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(compacted_particles_[i], particle_buffer_size_, i);
+      opencl_manager.Deallocate(group_alive_[i], (number_of_groups_+1)*sizeof(GGint), i);
+    }
+    delete[] compacted_particles_;
+    compacted_particles_ = nullptr;
+    delete[] group_alive_;
+    group_alive_ = nullptr;
+  }
+
+  if (kernel_count_alive_) {
+    delete[] kernel_count_alive_;
+    kernel_count_alive_ = nullptr;
+  }
+
+  if (kernel_scan_alive_) {
+    delete[] kernel_scan_alive_;
+    kernel_scan_alive_ = nullptr;
+  }
+
+  if (kernel_compact_particles_) {
+    delete[] kernel_compact_particles_;
+    kernel_compact_particles_ = nullptr;
+  }
+
   GGcout("GGEMSParticles", "~GGEMSParticles", 3) << "GGEMSParticles erased!!!" << GGendl;
 }
 
@@ -85,6 +121,19 @@ GGEMSParticles::~GGEMSParticles(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+GGsize GGEMSParticles::GetBufferSize(GGsize const& particle_capacity) const
+{
+  // Fields before particle arrays do not depend on capacity, each array grows linearly with capacity
+  GGsize header_size = offsetof(GGEMSPrimaryParticles, E_);
+  GGsize particle_size = (sizeof(GGEMSPrimaryParticles) - header_size) / MAXIMUM_PARTICLES;
+
+  return header_size + particle_size * particle_capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSParticles::SetNumberOfParticles(GGsize const& thread_index, GGsize const& number_of_particles)
 {
   number_of_particles_[thread_index] = number_of_particles;
@@ -128,6 +177,9 @@ void GGEMSParticles::Initialize(void)
 
   number_of_particles_ = new GGsize[number_activated_devices_];
 
+  // Size of buffer depends on capacity chosen before compiling kernels
+  particle_buffer_size_ = GetBufferSize(opencl_manager.GetParticleCapacity());
+
   // Allocation of the PrimaryParticle structure
   AllocatePrimaryParticles();
 
@@ -139,12 +191,126 @@ void GGEMSParticles::Initialize(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-bool GGEMSParticles::IsAlive(GGsize const& thread_index) const
+void GGEMSParticles::EnableCompaction(void)
+{
+  GGcout("GGEMSParticles", "EnableCompaction", 1) << "Allocation of buffers for compaction of particles..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  is_compaction_ = true;
+
+  // One counter per work-group plus the total
+  number_of_groups_ = opencl_manager.GetBestWorkItem(opencl_manager.GetParticleCapacity()) / opencl_manager.GetWorkGroupSize();
+
+  compacted_particles_ = new cl::Buffer*[number_activated_devices_];
+  group_alive_ = new cl::Buffer*[number_activated_devices_];
+
+  for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    compacted_particles_[i] = opencl_manager.Allocate(nullptr, particle_buffer_size_, i, CL_MEM_READ_WRITE, "GGEMSParticles");
+    group_alive_[i] = opencl_manager.Allocate(nullptr, (number_of_groups_+1)*sizeof(GGint), i, CL_MEM_READ_WRITE, "GGEMSParticles");
+  }
+
+  // Compiling kernels
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string filename = openCL_kernel_path + "/CompactParticles.cl";
+
+  kernel_count_alive_ = new cl::Kernel*[number_activated_devices_];
+  kernel_scan_alive_ = new cl::Kernel*[number_activated_devices_];
+  kernel_compact_particles_ = new cl::Kernel*[number_activated_devices_];
+
+  opencl_manager.CompileKernel(filename, "count_alive_particles", kernel_count_alive_, nullptr, nullptr);
+  opencl_manager.CompileKernel(filename, "scan_alive_particles", kernel_scan_alive_, nullptr, nullptr);
+  opencl_manager.CompileKernel(filename, "compact_particles", kernel_compact_particles_, nullptr, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSParticles::CompactParticles(GGsize const& thread_index)
 {
   // Get command queue and event
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
   cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
 
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSParticles::CompactParticles on " << device_name << ", index " << device_index;
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles_[thread_index]);
+  GGint number_of_groups = static_cast<GGint>(number_of_work_items / work_group_size);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+  cl::LocalSpaceArg scan = cl::Local(work_group_size*sizeof(GGint));
+
+  // Counting alive particles per work-group
+  kernel_count_alive_[thread_index]->setArg(0, number_of_particles_[thread_index]);
+  kernel_count_alive_[thread_index]->setArg(1, *primary_particles_[thread_index]);
+  kernel_count_alive_[thread_index]->setArg(2, *group_alive_[thread_index]);
+  kernel_count_alive_[thread_index]->setArg(3, scan);
+
+  cl::Event event_count;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_count_alive_[thread_index], 0, global_wi, local_wi, nullptr, &event_count);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSParticles", "CompactParticles");
+  GGEMSProfilerManager::GetInstance().HandleEvent(event_count, oss.str());
+
+  // Offset of each work-group, computed by a single work-group
+  kernel_scan_alive_[thread_index]->setArg(0, number_of_groups);
+  kernel_scan_alive_[thread_index]->setArg(1, *group_alive_[thread_index]);
+  kernel_scan_alive_[thread_index]->setArg(2, *status_[thread_index]);
+  kernel_scan_alive_[thread_index]->setArg(3, scan);
+
+  cl::Event event_scan;
+  kernel_status = queue->enqueueNDRangeKernel(*kernel_scan_alive_[thread_index], 0, local_wi, local_wi, nullptr, &event_scan);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSParticles", "CompactParticles");
+  GGEMSProfilerManager::GetInstance().HandleEvent(event_scan, oss.str());
+
+  // Copying alive particles
+  kernel_compact_particles_[thread_index]->setArg(0, number_of_particles_[thread_index]);
+  kernel_compact_particles_[thread_index]->setArg(1, *primary_particles_[thread_index]);
+  kernel_compact_particles_[thread_index]->setArg(2, *compacted_particles_[thread_index]);
+  kernel_compact_particles_[thread_index]->setArg(3, *group_alive_[thread_index]);
+  kernel_compact_particles_[thread_index]->setArg(4, scan);
+
+  cl::Event event_compact;
+  kernel_status = queue->enqueueNDRangeKernel(*kernel_compact_particles_[thread_index], 0, global_wi, local_wi, nullptr, &event_compact);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSParticles", "CompactParticles");
+  GGEMSProfilerManager::GetInstance().HandleEvent(event_compact, oss.str());
+
+  // Get number of alive particles, blocking map is the only synchronization point of the step
+  GGint* status_device = opencl_manager.GetDeviceBuffer<GGint>(status_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGint), thread_index);
+
+  GGsize number_of_alive_particles = static_cast<GGsize>(status_device[0]);
+
+  // Release the pointer
+  opencl_manager.ReleaseDeviceBuffer(status_[thread_index], status_device, thread_index);
+
+  // Compacted buffer becomes the primary buffer, next kernels are launched only on alive particles
+  std::swap(primary_particles_[thread_index], compacted_particles_[thread_index]);
+  number_of_particles_[thread_index] = number_of_alive_particles;
+
+  return number_of_alive_particles;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSParticles::IsAlive(GGsize const& thread_index)
+{
+  // Alive particles are packed and counted in the same pass
+  if (is_compaction_) return CompactParticles(thread_index) != 0;
+
+  // Get command queue and event
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
   // Get Device name and storing methode name + device
   GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
   std::string device_name = opencl_manager.GetDeviceName(device_index);
@@ -167,6 +333,7 @@ bool GGEMSParticles::IsAlive(GGsize const& thread_index) const
   kernel_alive_[thread_index]->setArg(0, number_of_particles_[thread_index]);
   kernel_alive_[thread_index]->setArg(1, *particles);
   kernel_alive_[thread_index]->setArg(2, *status);
+  kernel_alive_[thread_index]->setArg(3, cl::Local(work_group_size*sizeof(GGint)));
 
   // Launching kernel
   cl::Event event;
@@ -175,9 +342,8 @@ bool GGEMSParticles::IsAlive(GGsize const& thread_index) const
 
   // GGEMS Profiling
   GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
-  queue->finish();
 
-  // Get status from OpenCL device
+  // Get status from OpenCL device, blocking map is the only synchronization point of the step
   GGint* status_device = opencl_manager.GetDeviceBuffer<GGint>(status_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGint), thread_index);
 
   GGint status_from_device = status_device[0];
@@ -208,7 +374,7 @@ void GGEMSParticles::AllocatePrimaryParticles(void)
 
   // Loop over activated device and allocate particle buffer on each device
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    primary_particles_[i] = opencl_manager.Allocate(nullptr, sizeof(GGEMSPrimaryParticles), i, CL_MEM_READ_WRITE, "GGEMSParticles");
+    primary_particles_[i] = opencl_manager.Allocate(nullptr, particle_buffer_size_, i, CL_MEM_READ_WRITE, "GGEMSParticles");
     status_[i] = opencl_manager.Allocate(nullptr, sizeof(GGint), i, CL_MEM_READ_WRITE, "GGEMSParticles");
     opencl_manager.CleanBuffer(status_[i], sizeof(GGint), i);
   }
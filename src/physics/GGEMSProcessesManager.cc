@@ -28,6 +28,8 @@
   \date Monday March 9, 2020
 */
 
+#include <thread>
+
 #include "GGEMS/physics/GGEMSProcessesManager.hh"
 #include "GGEMS/navigators/GGEMSNavigatorManager.hh"
 #include "GGEMS/physics/GGEMSCrossSections.hh"
@@ -41,7 +43,9 @@ GGEMSProcessesManager::GGEMSProcessesManager(void)
 : cross_section_table_number_of_bins_(CROSS_SECTION_TABLE_NUMBER_BINS),
   cross_section_table_min_energy_(CROSS_SECTION_TABLE_ENERGY_MIN),
   cross_section_table_max_energy_(CROSS_SECTION_TABLE_ENERGY_MAX),
-  is_processes_print_tables_(false)
+  is_processes_print_tables_(false),
+  physic_tables_cache_directory_(""),
+  number_of_host_threads_(std::max(static_cast<GGsize>(std::thread::hardware_concurrency()), static_cast<GGsize>(1)))
 {
   GGcout("GGEMSProcessesManager", "GGEMSProcessesManager", 3) << "GGEMSProcessesManager creating..." << GGendl;
 
@@ -74,6 +78,69 @@ void GGEMSProcessesManager::Clean(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+cl::Buffer* const* GGEMSProcessesManager::GetSharedTables(std::string const& table_key)
+{
+  auto iter = shared_tables_.find(table_key);
+  if (iter == shared_tables_.end()) return nullptr;
+
+  shared_tables_users_[table_key] += 1;
+  return iter->second.data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSProcessesManager::RegisterSharedTables(std::string const& table_key, cl::Buffer* const* tables, GGsize const& number_of_activated_devices)
+{
+  shared_tables_[table_key] = std::vector<cl::Buffer*>(tables, tables + number_of_activated_devices);
+  shared_tables_users_[table_key] = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSProcessesManager::ReleaseSharedTables(std::string const& table_key)
+{
+  auto iter = shared_tables_users_.find(table_key);
+  if (iter == shared_tables_users_.end()) return true;
+
+  iter->second -= 1;
+  if (iter->second != 0) return false;
+
+  // Last user, tables are removed from registry and deallocated by the caller
+  shared_tables_users_.erase(iter);
+  shared_tables_.erase(table_key);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSProcessesManager::SetPhysicTablesCacheDirectory(std::string const& directory)
+{
+  physic_tables_cache_directory_ = directory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSProcessesManager::SetNumberOfHostThreads(GGsize const& number_of_threads)
+{
+  if (number_of_threads == 0) {
+    GGEMSMisc::ThrowException("GGEMSProcessesManager", "SetNumberOfHostThreads", "Number of host threads must be at least 1!!!");
+  }
+
+  number_of_host_threads_ = number_of_threads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSProcessesManager::SetCrossSectionTableNumberOfBins(GGsize const& number_of_bins)
 {
   cross_section_table_number_of_bins_ = number_of_bins;
@@ -264,3 +331,21 @@ void print_tables_processes_manager(GGEMSProcessesManager* processes_manager, bo
 {
   processes_manager->PrintPhysicTables(is_processes_print_tables);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_physic_tables_cache_directory_processes_manager(GGEMSProcessesManager* processes_manager, char const* directory)
+{
+  processes_manager->SetPhysicTablesCacheDirectory(directory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_number_of_host_threads_processes_manager(GGEMSProcessesManager* processes_manager, GGsize const number_of_threads)
+{
+  processes_manager->SetNumberOfHostThreads(number_of_threads);
+}
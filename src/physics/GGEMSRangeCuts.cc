@@ -599,30 +599,46 @@ void GGEMSRangeCuts::ConvertCutsFromDistanceToEnergy(GGEMSMaterials* materials)
   // Get number of activated device
   GGsize number_activated_devices = opencl_manager.GetNumberOfActivatedDevice();
 
-  for (GGsize j = 0; j < number_activated_devices; ++j) {
-    cl::Buffer* material_table = materials->GetMaterialTables(j);
-    GGEMSMaterialTables* material_table_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(material_table, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), j);
-
-    // Loop over materials
-    for (GGushort i = 0; i < material_table_device->number_of_materials_; ++i) {
-      // Get the name of material
-
-      // Convert photon cuts
-      GGfloat energy_cut_photon = ConvertToEnergy(material_table_device, i, "gamma");
-
-      // Convert electron cuts
-      GGfloat energy_cut_electron = ConvertToEnergy(material_table_device, i, "e-");
-
-      // Convert electron cuts
-      GGfloat energy_cut_positron = ConvertToEnergy(material_table_device, i, "e+");
-
-      // Storing the cuts in map
-      energy_cuts_photon_.insert(std::make_pair(materials->GetMaterialName(i), energy_cut_photon));
-      energy_cuts_electron_.insert(std::make_pair(materials->GetMaterialName(i), energy_cut_electron));
-      energy_cuts_positron_.insert(std::make_pair(materials->GetMaterialName(i), energy_cut_positron));
+  // Cuts are computed once with materials of first device
+  cl::Buffer* material_table = materials->GetMaterialTables(0);
+  GGEMSMaterialTables* material_table_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(material_table, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), 0);
+
+  // Loop over materials, loss tables are members so each host thread uses its own range cuts
+  GGsize number_of_materials = static_cast<GGsize>(material_table_device->number_of_materials_);
+  GGEMSMisc::ParallelFor(number_of_materials, process_manager.GetNumberOfHostThreads(), [&](GGsize const& i) {
+    GGEMSRangeCuts range_cuts;
+    range_cuts.min_energy_ = min_energy_;
+    range_cuts.distance_cut_photon_ = distance_cut_photon_;
+    range_cuts.distance_cut_electron_ = distance_cut_electron_;
+    range_cuts.distance_cut_positron_ = distance_cut_positron_;
+
+    // Convert photon, electron and positron cuts, stored in material table
+    range_cuts.ConvertToEnergy(material_table_device, static_cast<GGushort>(i), "gamma");
+    range_cuts.ConvertToEnergy(material_table_device, static_cast<GGushort>(i), "e-");
+    range_cuts.ConvertToEnergy(material_table_device, static_cast<GGushort>(i), "e+");
+  });
+
+  // Storing the cuts in map
+  for (GGsize i = 0; i < number_of_materials; ++i) {
+    energy_cuts_photon_.insert(std::make_pair(materials->GetMaterialName(i), material_table_device->photon_energy_cut_[i]));
+    energy_cuts_electron_.insert(std::make_pair(materials->GetMaterialName(i), material_table_device->electron_energy_cut_[i]));
+    energy_cuts_positron_.insert(std::make_pair(materials->GetMaterialName(i), material_table_device->positron_energy_cut_[i]));
+  }
+
+  // Copy cuts on other devices
+  for (GGsize j = 1; j < number_activated_devices; ++j) {
+    cl::Buffer* other_material_table = materials->GetMaterialTables(j);
+    GGEMSMaterialTables* other_material_table_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(other_material_table, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), j);
+
+    for (GGsize i = 0; i < number_of_materials; ++i) {
+      other_material_table_device->photon_energy_cut_[i] = material_table_device->photon_energy_cut_[i];
+      other_material_table_device->electron_energy_cut_[i] = material_table_device->electron_energy_cut_[i];
+      other_material_table_device->positron_energy_cut_[i] = material_table_device->positron_energy_cut_[i];
     }
 
-    // Release pointer
-    opencl_manager.ReleaseDeviceBuffer(material_table, material_table_device, j);
+    opencl_manager.ReleaseDeviceBuffer(other_material_table, other_material_table_device, j);
   }
+
+  // Release pointer
+  opencl_manager.ReleaseDeviceBuffer(material_table, material_table_device, 0);
 }
@@ -28,12 +28,14 @@
   \date Monday December 16, 2019
 */
 
-#include <random>
+#include <algorithm>
+#include <cstddef>
 
 #include "GGEMS/randoms/GGEMSPseudoRandomGenerator.hh"
 #include "GGEMS/randoms/GGEMSRandom.hh"
 
 #include "GGEMS/tools/GGEMSRAMManager.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
 
 #include "GGEMS/sources/GGEMSSourceManager.hh"
 
@@ -50,7 +52,9 @@
 
 GGEMSPseudoRandomGenerator::GGEMSPseudoRandomGenerator(void)
 : pseudo_random_numbers_(nullptr),
-  seed_(0)
+  seed_(0),
+  is_philox_(false),
+  random_size_(0)
 {
   GGcout("GGEMSPseudoRandomGenerator", "GGEMSPseudoRandomGenerator", 3) << "GGEMSPseudoRandomGenerator creating..." << GGendl;
 
@@ -69,7 +73,7 @@ GGEMSPseudoRandomGenerator::~GGEMSPseudoRandomGenerator(void)
 
   if (pseudo_random_numbers_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(pseudo_random_numbers_[i], sizeof(GGEMSRandom), i);
+      opencl_manager.Deallocate(pseudo_random_numbers_[i], random_size_, i);
     }
     delete[] pseudo_random_numbers_;
     pseudo_random_numbers_ = nullptr;
@@ -126,40 +130,97 @@ void GGEMSPseudoRandomGenerator::Initialize(GGuint const& seed)
 
   seed_ = seed == 0 ? GenerateSeed() : seed;
 
+  // Philox engine is selected at kernel compilation, before compiling any kernel
+  if (is_philox_) GGEMSOpenCLManager::GetInstance().AddBuildOption("-DPHILOX");
+
+  // Size of buffer depends on engine and capacity chosen before compiling kernels
+  random_size_ = GetBufferSize(GGEMSOpenCLManager::GetInstance().GetParticleCapacity());
+
   // Allocation of the Random structure
   AllocateRandom();
 
-  // Generate seeds for each particle
-  InitializeSeeds();
+  // Generate seeds for each particle, Philox only needs a key
+  if (is_philox_) InitializePhiloxKeys();
+  else InitializeSeeds();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSPseudoRandomGenerator::InitializeSeeds(void)
+GGsize GGEMSPseudoRandomGenerator::GetBufferSize(GGsize const& particle_capacity) const
 {
-  GGcout("GGEMSPseudoRandomGenerator", "InitializeSeeds", 1) << "Initialization of seeds for each particles..." << GGendl;
+  // Philox key does not depend on capacity, each state array grows linearly with capacity
+  if (is_philox_) {
+    GGsize key_size = offsetof(GGEMSPhiloxRandom, prng_counter_);
+    return key_size + (sizeof(GGEMSPhiloxRandom) - key_size) / MAXIMUM_PARTICLES * particle_capacity;
+  }
+  else {
+    return sizeof(GGEMSRandom) / MAXIMUM_PARTICLES * particle_capacity;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPseudoRandomGenerator::SetSeed(GGuint const& seed)
+{
+  seed_ = seed == 0 ? GenerateSeed() : seed;
 
-  // Initialize the Mersenne Twister engine
-  std::mt19937 mt_gen(seed_);
+  GGcout("GGEMSPseudoRandomGenerator", "SetSeed", 1) << "Seeding random streams again with seed " << seed_ << "..." << GGendl;
+
+  // Buffers are already allocated, only keys or states are computed again
+  if (is_philox_) InitializePhiloxKeys();
+  else InitializeSeeds();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPseudoRandomGenerator::SetEngine(std::string const& engine)
+{
+  std::string engine_name = engine;
+  std::transform(engine_name.begin(), engine_name.end(), engine_name.begin(), ::tolower);
+
+  if (engine_name == "jkiss") {
+    is_philox_ = false;
+  }
+  else if (engine_name == "philox") {
+    is_philox_ = true;
+  }
+  else {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Unknown random engine '" << engine << "'!!! Available engines are:" << std::endl;
+    oss << "    - 'jkiss'" << std::endl;
+    oss << "    - 'philox'" << std::endl;
+    GGEMSMisc::ThrowException("GGEMSPseudoRandomGenerator", "SetEngine", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPseudoRandomGenerator::InitializePhiloxKeys(void)
+{
+  GGcout("GGEMSPseudoRandomGenerator", "InitializePhiloxKeys", 1) << "Initialization of Philox keys..." << GGendl;
 
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
   // Loop over activated device
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    // Draw counters start from 0
+    opencl_manager.CleanBuffer(pseudo_random_numbers_[i], random_size_, i);
+
     // Get the pointer on device
-    GGEMSRandom* random_device = opencl_manager.GetDeviceBuffer<GGEMSRandom>(pseudo_random_numbers_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSRandom), i);
-
-    // For each particle a seed is generated
-    for (GGsize j = 0; j < MAXIMUM_PARTICLES; ++j) {
-      random_device->prng_state_1_[j] = static_cast<GGuint>(mt_gen());
-      random_device->prng_state_2_[j] = static_cast<GGuint>(mt_gen());
-      random_device->prng_state_3_[j] = static_cast<GGuint>(mt_gen());
-      random_device->prng_state_4_[j] = static_cast<GGuint>(mt_gen());
-      random_device->prng_state_5_[j] = 0;
-    }
+    GGEMSPhiloxRandom* random_device = opencl_manager.GetDeviceBuffer<GGEMSPhiloxRandom>(pseudo_random_numbers_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, random_size_, i);
+
+    // Same seed on each device, streams are separated by the device index
+    random_device->prng_key_[0] = seed_;
+    random_device->prng_key_[1] = static_cast<GGuint>(i);
 
     // Release the pointer, mandatory step!!!
     opencl_manager.ReleaseDeviceBuffer(pseudo_random_numbers_[i], random_device, i);
@@ -170,6 +231,59 @@ void GGEMSPseudoRandomGenerator::InitializeSeeds(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSPseudoRandomGenerator::InitializeSeeds(void)
+{
+  GGcout("GGEMSPseudoRandomGenerator", "InitializeSeeds", 1) << "Initialization of seeds for each particles..." << GGendl;
+
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Compiling seeding kernel, used only once
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string filename = openCL_kernel_path + "/InitializeRandom.cl";
+  cl::Kernel** kernel_initialize_random = new cl::Kernel*[number_activated_devices_];
+  opencl_manager.CompileKernel(filename, "initialize_random", kernel_initialize_random, nullptr, nullptr);
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize particle_capacity = opencl_manager.GetParticleCapacity();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(particle_capacity);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Loop over activated device, state of each particle is computed on device from seed, device and particle index
+  for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    cl::CommandQueue* queue = opencl_manager.GetCommandQueue(i);
+
+    // Get Device name and storing methode name + device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(i);
+    std::string device_name = opencl_manager.GetDeviceName(device_index);
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "GGEMSPseudoRandomGenerator::InitializeSeeds on " << device_name << ", index " << device_index;
+
+    kernel_initialize_random[i]->setArg(0, particle_capacity);
+    kernel_initialize_random[i]->setArg(1, *pseudo_random_numbers_[i]);
+    kernel_initialize_random[i]->setArg(2, seed_);
+    kernel_initialize_random[i]->setArg(3, static_cast<GGuint>(i));
+
+    // Launching kernel
+    cl::Event event;
+    GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_initialize_random[i], 0, global_wi, local_wi, nullptr, &event);
+    opencl_manager.CheckOpenCLError(kernel_status, "GGEMSPseudoRandomGenerator", "InitializeSeeds");
+
+    // GGEMS Profiling
+    GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+  }
+
+  delete[] kernel_initialize_random;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSPseudoRandomGenerator::AllocateRandom(void)
 {
   GGcout("GGEMSPseudoRandomGenerator", "AllocateRandom", 1) << "Allocation of random numbers..." << GGendl;
@@ -183,7 +297,7 @@ void GGEMSPseudoRandomGenerator::AllocateRandom(void)
   // Allocation of memory on OpenCL device
   pseudo_random_numbers_ = new cl::Buffer*[number_activated_devices_];
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    pseudo_random_numbers_[i] = opencl_manager.Allocate(nullptr, sizeof(GGEMSRandom), i, CL_MEM_READ_WRITE, "GGEMSPseudoRandomGenerator");
+    pseudo_random_numbers_[i] = opencl_manager.Allocate(nullptr, random_size_, i, CL_MEM_READ_WRITE, "GGEMSPseudoRandomGenerator");
   }
 }
 
@@ -199,28 +313,29 @@ void GGEMSPseudoRandomGenerator::PrintInfos(void) const
   // Getting OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
+  // Philox has no state to print, only its key
+  if (is_philox_) {
+    GGcout("GGEMSPseudoRandomGenerator", "PrintInfos", 0) << "Engine: Philox4x32-10, key (seed, device index)" << GGendl;
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(i);
+      GGcout("GGEMSPseudoRandomGenerator", "PrintInfos", 0) << "Device: " << opencl_manager.GetDeviceName(device_index) << ", key: " << seed_ << " " << i << GGendl;
+    }
+    return;
+  }
+
+  GGsize particle_capacity = opencl_manager.GetParticleCapacity();
+
   // Loop over the activated devices
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
     GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(i);
 
-    GGEMSRandom* random_device = opencl_manager.GetDeviceBuffer<GGEMSRandom>(pseudo_random_numbers_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSRandom), i);
-
-    GGuint state[2][5] = {
-      {
-        random_device->prng_state_1_[0],
-        random_device->prng_state_2_[0],
-        random_device->prng_state_3_[0],
-        random_device->prng_state_4_[0],
-        random_device->prng_state_5_[0]
-      },
-      {
-        random_device->prng_state_1_[1],
-        random_device->prng_state_2_[1],
-        random_device->prng_state_3_[1],
-        random_device->prng_state_4_[1],
-        random_device->prng_state_5_[1]
-      }
-    };
+    // States are stored one after the other, each one with the capacity of particle buffer
+    GGuint* random_device = opencl_manager.GetDeviceBuffer<GGuint>(pseudo_random_numbers_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, random_size_, i);
+
+    GGuint state[2][5];
+    for (GGsize j = 0; j < 2; ++j) {
+      for (GGsize k = 0; k < 5; ++k) state[j][k] = random_device[k*particle_capacity+j];
+    }
 
     // Release the pointer, mandatory step!!!
     opencl_manager.ReleaseDeviceBuffer(pseudo_random_numbers_[i], random_device, i);
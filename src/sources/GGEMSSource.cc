@@ -28,6 +28,8 @@
   \date Tuesday October 15, 2019
 */
 
+#include <algorithm>
+
 #include "GGEMS/global/GGEMSConstants.hh"
 #include "GGEMS/sources/GGEMSSourceManager.hh"
 #include "GGEMS/maths/GGEMSGeometryTransformation.hh"
@@ -44,6 +46,9 @@ GGEMSSource::GGEMSSource(std::string const& source_name)
   number_of_particles_by_device_(nullptr),
   number_of_particles_in_batch_(nullptr),
   number_of_batchs_(nullptr),
+  number_of_shared_batchs_(0),
+  minimum_number_of_batchs_(1),
+  next_shared_batch_(0),
   particle_type_(99),
   tracking_kernel_option_("")
 {
@@ -78,29 +83,12 @@ GGEMSSource::~GGEMSSource(void)
     geometry_transformation_ = nullptr;
   }
 
-  if (number_of_batchs_) {
-    delete number_of_batchs_;
-    number_of_batchs_ = nullptr;
-  }
-
-  if (number_of_particles_by_device_) {
-    delete number_of_particles_by_device_;
-    number_of_particles_by_device_ = nullptr;
-  }
-
   if (kernel_get_primaries_) {
     delete[] kernel_get_primaries_;
     kernel_get_primaries_ = nullptr;
   }
 
-  if (number_of_particles_in_batch_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      delete number_of_particles_in_batch_[i];
-      number_of_particles_in_batch_[i] = nullptr;
-    }
-    delete[] number_of_particles_in_batch_;
-    number_of_particles_in_batch_ = nullptr;
-  }
+  DeleteBatchs();
 
   GGcout("GGEMSSource", "~GGEMSSource", 3) << "GGEMSSource erased!!!" << GGendl;
 }
@@ -140,6 +128,15 @@ void GGEMSSource::SetNumberOfParticles(GGsize const& number_of_particles)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSource::SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs)
+{
+  minimum_number_of_batchs_ = minimum_number_of_batchs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSource::SetSourceParticleType(std::string const& particle_type)
 {
   if (particle_type == "gamma") {
@@ -174,6 +171,19 @@ void GGEMSSource::SetRotation(GGfloat const& rx, GGfloat const& ry, GGfloat cons
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSource::RotateGantry(GGfloat const& angle)
+{
+  GGfloat3 rotation;
+  rotation.s[0] = 0.0f;
+  rotation.s[1] = 0.0f;
+  rotation.s[2] = angle;
+  geometry_transformation_->SetRotation(rotation);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSource::CheckParameters(void) const
 {
   GGcout("GGEMSSource", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
@@ -223,10 +233,39 @@ void GGEMSSource::CheckParameters(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSource::DeleteBatchs(void)
+{
+  if (number_of_batchs_) {
+    delete[] number_of_batchs_;
+    number_of_batchs_ = nullptr;
+  }
+
+  if (number_of_particles_by_device_) {
+    delete[] number_of_particles_by_device_;
+    number_of_particles_by_device_ = nullptr;
+  }
+
+  if (number_of_particles_in_batch_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      delete[] number_of_particles_in_batch_[i];
+      number_of_particles_in_batch_[i] = nullptr;
+    }
+    delete[] number_of_particles_in_batch_;
+    number_of_particles_in_batch_ = nullptr;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSource::OrganizeParticlesInBatch(void)
 {
   GGcout("GGEMSSource", "OrganizeParticlesInBatch", 3) << "Organizing the number of particles in batch..." << GGendl;
 
+  // Batchs of a previous run are deleted
+  DeleteBatchs();
+
   // Getting OpenCL singleton
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
@@ -255,11 +294,21 @@ void GGEMSSource::OrganizeParticlesInBatch(void)
     }
   }
 
-  // Computing number of batch for each device
+  // Computing number of batch for each device, a batch fills at most the particle buffer
+  GGsize particle_capacity = opencl_manager.GetParticleCapacity();
+
+  // Same maximum batch size on all devices, so the whole run is split in at least the minimum number of batchs of close sizes
+  GGsize batch_size = particle_capacity;
+  if (minimum_number_of_batchs_ > 1) {
+    GGsize split_batch_size = number_of_particles_ / minimum_number_of_batchs_;
+    if (split_batch_size == 0) split_batch_size = 1;
+    if (split_batch_size < batch_size) batch_size = split_batch_size;
+  }
+
   number_of_particles_in_batch_ = new GGsize*[number_activated_devices_];
   number_of_batchs_ = new GGsize[number_activated_devices_];
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    number_of_batchs_[i] = static_cast<GGsize>(std::ceil(static_cast<GGfloat>(number_of_particles_by_device_[i]) / MAXIMUM_PARTICLES));
+    number_of_batchs_[i] = (number_of_particles_by_device_[i] + batch_size - 1) / batch_size;
 
     number_of_particles_in_batch_[i] = new GGsize[number_of_batchs_[i]];
 
@@ -278,6 +327,36 @@ void GGEMSSource::OrganizeParticlesInBatch(void)
       }
     }
   }
+
+  // Batchs shared by all devices in work-queue mode, at least one batch by device if possible
+  number_of_shared_batchs_ = (number_of_particles_ + batch_size - 1) / batch_size;
+  number_of_shared_batchs_ = std::max(number_of_shared_batchs_, std::min(number_of_particles_, number_activated_devices_));
+  ResetSharedBatchs();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSSource::PullBatch(GGsize& number_of_particles)
+{
+  GGsize batch_index = next_shared_batch_.fetch_add(1);
+  if (batch_index >= number_of_shared_batchs_) return false;
+
+  // Remaining particles are given to first batchs
+  number_of_particles = number_of_particles_ / number_of_shared_batchs_;
+  if (batch_index < number_of_particles_ % number_of_shared_batchs_) ++number_of_particles;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSource::ResetSharedBatchs(void)
+{
+  next_shared_batch_ = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,3 +378,18 @@ void GGEMSSource::Initialize(bool const& is_tracking)
 
   GGcout("GGEMSSource", "Initialize", 0) << "Particles arranged in batch OK" << GGendl;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSource::Update(void)
+{
+  GGcout("GGEMSSource", "Update", 3) << "Updating the GGEMS source for a new run..." << GGendl;
+
+  // Checking the parameters of source, they could be modified since previous run
+  CheckParameters();
+
+  // Organize the particles in batch
+  OrganizeParticlesInBatch();
+}
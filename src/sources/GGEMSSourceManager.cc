@@ -28,6 +28,8 @@
   \date Thursday January 16, 2020
 */
 
+#include <cstddef>
+
 #include "GGEMS/sources/GGEMSSourceManager.hh"
 #include "GGEMS/physics/GGEMSPrimaryParticles.hh"
 #include "GGEMS/randoms/GGEMSPseudoRandomGenerator.hh"
@@ -149,6 +151,42 @@ GGsize GGEMSSourceManager::GetTotalNumberOfBatchs(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+GGsize GGEMSSourceManager::GetTotalNumberOfSharedBatchs(void) const
+{
+  GGsize total_number_of_batchs = 0;
+  for (GGsize i = 0; i < number_of_sources_; ++i) {
+    total_number_of_batchs += sources_[i]->GetNumberOfSharedBatchs();
+  }
+
+  return total_number_of_batchs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSourceManager::ResetSharedBatchs(void) const
+{
+  for (GGsize i = 0; i < number_of_sources_; ++i) {
+    sources_[i]->ResetSharedBatchs();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSourceManager::RotateGantry(GGfloat const& angle) const
+{
+  for (GGsize i = 0; i < number_of_sources_; ++i) {
+    sources_[i]->RotateGantry(angle);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSourceManager::Initialize(GGuint const& seed, bool const& is_tracking, GGint const& particle_tracking_id) const
 {
   GGcout("GGEMSSourceManager", "Initialize", 3) << "Initializing the GGEMS source(s)..." << GGendl;
@@ -177,8 +215,8 @@ void GGEMSSourceManager::Initialize(GGuint const& seed, bool const& is_tracking,
 
     // Loop over activated device
     for (GGsize i = 0; i < opencl_manager.GetNumberOfActivatedDevice(); ++i) {
-      // Get pointer on OpenCL device for particles
-      GGEMSPrimaryParticles* primary_particles_device = opencl_manager.GetDeviceBuffer<GGEMSPrimaryParticles>(particles_->GetPrimaryParticles(i), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSPrimaryParticles), i);
+      // Get pointer on OpenCL device for particles, only fields before particle arrays are mapped
+      GGEMSPrimaryParticles* primary_particles_device = opencl_manager.GetDeviceBuffer<GGEMSPrimaryParticles>(particles_->GetPrimaryParticles(i), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, offsetof(GGEMSPrimaryParticles, E_), i);
 
       primary_particles_device->particle_tracking_id = particle_tracking_id;
 
@@ -192,6 +230,26 @@ void GGEMSSourceManager::Initialize(GGuint const& seed, bool const& is_tracking,
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSourceManager::Update(void) const
+{
+  GGcout("GGEMSSourceManager", "Update", 3) << "Updating the GGEMS source(s)..." << GGendl;
+
+  for (GGsize i = 0; i < number_of_sources_; ++i) sources_[i]->Update();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSourceManager::SetMinimumNumberOfBatchs(GGsize const& minimum_number_of_batchs) const
+{
+  for (GGsize i = 0; i < number_of_sources_; ++i) sources_[i]->SetMinimumNumberOfBatchs(minimum_number_of_batchs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 bool GGEMSSourceManager::IsAlive(GGsize const& thread_index) const
 {
   // Check if all particles are DEAD in OpenCL particle buffer
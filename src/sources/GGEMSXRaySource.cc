@@ -69,6 +69,10 @@ GGEMSXRaySource::GGEMSXRaySource(std::string const& source_name)
   // Allocating memory for cdf and energy spectrum
   energy_spectrum_ = new cl::Buffer*[number_activated_devices_];
   cdf_ = new cl::Buffer*[number_activated_devices_];
+  for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    energy_spectrum_[i] = nullptr;
+    cdf_[i] = nullptr;
+  }
 
   GGcout("GGEMSXRaySource", "GGEMSXRaySource", 3) << "GGEMSXRaySource created!!!" << GGendl;
 }
@@ -81,31 +85,14 @@ GGEMSXRaySource::~GGEMSXRaySource(void)
 {
   GGcout("GGEMSXRaySource", "~GGEMSXRaySource", 3) << "GGEMSXRaySource erasing..." << GGendl;
 
-  // Get the OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  ReleaseEnergy();
 
   if (energy_spectrum_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      if (is_monoenergy_mode_) {
-        opencl_manager.Deallocate(energy_spectrum_[i], 2*sizeof(GGfloat), i);
-      }
-      else {
-        opencl_manager.Deallocate(energy_spectrum_[i], number_of_energy_bins_*sizeof(GGfloat), i);
-      }
-    }
     delete[] energy_spectrum_;
     energy_spectrum_ = nullptr;
   }
 
   if (cdf_) {
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      if (is_monoenergy_mode_) {
-        opencl_manager.Deallocate(cdf_[i], 2*sizeof(GGfloat), i);
-      }
-      else {
-        opencl_manager.Deallocate(cdf_[i], number_of_energy_bins_*sizeof(GGfloat), i);
-      }
-    }
     delete[] cdf_;
     cdf_ = nullptr;
   }
@@ -154,9 +141,9 @@ void GGEMSXRaySource::GetPrimaries(GGsize const& thread_index, GGsize const& num
   cl::Buffer* randoms = source_manager.GetPseudoRandomGenerator()->GetPseudoRandomNumbers(thread_index);
   cl::Buffer* matrix_transformation = geometry_transformation_->GetTransformationMatrix(thread_index);
 
-  // Getting work group size, and work-item number
-  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
-  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
+  // Getting work group size of kernel, and work-item number
+  GGsize work_group_size = opencl_manager.GetKernelWorkGroupSize(kernel_get_primaries_[thread_index]);
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles, work_group_size);
 
   // Parameters for work-item in kernel
   cl::NDRange global_wi(number_of_work_items);
@@ -178,11 +165,11 @@ void GGEMSXRaySource::GetPrimaries(GGsize const& thread_index, GGsize const& num
   cl::Event event;
   GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_get_primaries_[thread_index], 0, global_wi, local_wi, nullptr, &event);
   opencl_manager.CheckOpenCLError(kernel_status, "GGEMSXRaySource", "GetPrimaries");
+  opencl_manager.TuneKernelWorkGroupSize(kernel_get_primaries_[thread_index], event, number_of_work_items);
 
   // GGEMS Profiling
   GGEMSProfilerManager& profiler_manager = GGEMSProfilerManager::GetInstance();
   profiler_manager.HandleEvent(event, oss.str());
-  queue->finish();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -326,6 +313,31 @@ void GGEMSXRaySource::CheckParameters(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSXRaySource::ReleaseEnergy(void)
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // In monoenergy mode, 2 bins are stored
+  for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    if (energy_spectrum_[i]) {
+      opencl_manager.Deallocate(energy_spectrum_[i], number_of_energy_bins_*sizeof(GGfloat), i);
+      energy_spectrum_[i] = nullptr;
+    }
+
+    if (cdf_[i]) {
+      opencl_manager.Deallocate(cdf_[i], number_of_energy_bins_*sizeof(GGfloat), i);
+      cdf_[i] = nullptr;
+    }
+  }
+
+  number_of_energy_bins_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSXRaySource::FillEnergy(void)
 {
   GGcout("GGEMSXRaySource", "FillEnergy", 3) << "Filling energy..." << GGendl;
@@ -333,6 +345,9 @@ void GGEMSXRaySource::FillEnergy(void)
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
+  // Energy of a previous run is replaced
+  ReleaseEnergy();
+
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
     // Monoenergy mode
     if (is_monoenergy_mode_) {
@@ -443,6 +458,21 @@ void GGEMSXRaySource::Initialize(bool const& is_tracking)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSXRaySource::Update(void)
+{
+  GGcout("GGEMSXRaySource", "Update", 3) << "Updating the GGEMS X-Ray source..." << GGendl;
+
+  // Update GGEMS source
+  GGEMSSource::Update();
+
+  // Energy spectrum is read again, mono or polyenergy mode could be modified
+  FillEnergy();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSXRaySource::SetBeamAperture(GGfloat const& beam_aperture, std::string const& unit)
 {
   beam_aperture_ = AngleUnit(beam_aperture, unit);
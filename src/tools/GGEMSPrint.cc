@@ -35,6 +35,12 @@ GGEMSStream GGcout = GGEMSStream(std::cout, GGEMSConsoleColor::green);
 GGEMSStream GGcerr = GGEMSStream(std::cerr, GGEMSConsoleColor::red);
 GGEMSStream GGwarn = GGEMSStream(std::cout, GGEMSConsoleColor::yellow);
 
+// Messages from this thread are not printed, not a member because thread local data can not be exported in DLL
+namespace
+{
+  thread_local bool is_thread_muted = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,9 +68,25 @@ void GGEMSStream::SetVerbosity(GGint const& verbosity_limit)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSStream::MuteThread(void)
+{
+  is_thread_muted = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 GGEMSStream& GGEMSStream::operator()(std::string const& class_name,
   std::string const& method_name, GGint const& verbosity_level)
 {
+  // Members are shared by all threads, a muted thread uses its own silent stream
+  if (is_thread_muted) {
+    thread_local GGEMSStream muted_stream(stream_, color_index_);
+    muted_stream.verbosity_limit_ = -1;
+    return muted_stream;
+  }
+
   class_name_ = class_name;
   method_name_ = method_name;
   verbosity_level_ = verbosity_level;
@@ -94,6 +94,17 @@ void GGEMSProfiler::AddProfilerItem(cl_event event)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+DurationNano GGEMSProfiler::GetSummaryTime(void) const
+{
+  // Same mutex as call back function, profiler item is updated by OpenCL threads
+  std::lock_guard<std::mutex> lock(mutex);
+  return profiler_item_ ? profiler_item_->GetElapsedTime() : GGEMSChrono::Zero();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSProfiler::HandleEvent(cl::Event& event)
 {
   clRetainEvent(event());
@@ -110,6 +110,22 @@ void GGEMSProfilerManager::PrintSummaryProfile(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+ProfileTimeMap GGEMSProfilerManager::GetSummaryProfile(void) const
+{
+  ProfileTimeMap summary_profile;
+
+  // Mutex of manager protects the list of profilers, times of profilers are locked by GGEMSProfiler
+  mutex.lock();
+  for (auto&& p: profilers_) summary_profile.insert(std::make_pair(p.first, p.second.GetSummaryTime()));
+  mutex.unlock();
+
+  return summary_profile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSProfilerManager::Reset(void)
 {
   profilers_.clear();
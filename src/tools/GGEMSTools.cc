@@ -29,8 +29,15 @@
 */
 
 #include <sstream>
+#include <iomanip>
+#include <cstdint>
 #include <cerrno>
 #include <cstring>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <exception>
+#include <algorithm>
 
 #include "GGEMS/tools/GGEMSTools.hh"
 #include "GGEMS/tools/GGEMSPrint.hh"
@@ -63,5 +70,80 @@ void GGEMSFileStream::CheckInputStream(std::ifstream const& input_stream, std::s
   std::ostringstream oss(std::ostringstream::out);
   oss << message;
   GGcerr(class_name, method_name, 0) << oss.str() << GGendl;
-  throw std::runtime_error("");
+  throw std::runtime_error(oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GGEMSMisc::HashContent(std::string const& content)
+{
+  // FNV-1a 64 bits hash
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char const& c : content) {
+    hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(c));
+    hash *= 0x100000001b3ULL;
+  }
+
+  std::ostringstream oss(std::ostringstream::out);
+  oss << std::hex << std::setfill('0') << std::setw(16) << hash;
+  return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMisc::ParallelFor(GGsize const& number_of_tasks, GGsize const& number_of_threads, std::function<void(GGsize const&)> const& task)
+{
+  GGsize number_of_workers = std::min(std::max(number_of_threads, static_cast<GGsize>(1)), number_of_tasks);
+
+  // No thread created for a single worker
+  if (number_of_workers <= 1) {
+    for (GGsize i = 0; i < number_of_tasks; ++i) task(i);
+    return;
+  }
+
+  // Tasks are taken one by one, costs of tasks may be very different
+  std::atomic<GGsize> next_task(0);
+  std::vector<std::exception_ptr> exceptions(number_of_workers);
+
+  auto worker = [&](GGsize const worker_index) {
+    // GGEMS streams are shared, only calling thread prints messages
+    if (worker_index != 0) GGEMSStream::MuteThread();
+
+    try {
+      for (GGsize i = next_task++; i < number_of_tasks; i = next_task++) task(i);
+    }
+    catch (...) {
+      exceptions[worker_index] = std::current_exception();
+      next_task = number_of_tasks;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_workers-1);
+  for (GGsize i = 1; i < number_of_workers; ++i) threads.emplace_back(worker, i);
+  worker(0);
+  for (auto&& t : threads) t.join();
+
+  for (GGsize i = 0; i < number_of_workers; ++i) {
+    if (!exceptions[i]) continue;
+
+    // Message of additional thread was muted, printing it from calling thread
+    if (i != 0) {
+      try {
+        std::rethrow_exception(exceptions[i]);
+      }
+      catch (std::exception const& e) {
+        GGcerr("GGEMSMisc", "ParallelFor", 0) << e.what() << GGendl;
+      }
+      catch (...) {
+        GGcerr("GGEMSMisc", "ParallelFor", 0) << "Unknown exception in host thread " << i << GGendl;
+      }
+    }
+
+    std::rethrow_exception(exceptions[i]);
+  }
 }